@@ -0,0 +1,277 @@
+// Benchmarks of the scheduler core (Google Benchmark)
+//
+// Build with -DRT_SCHED_BENCH=ON, then for example
+//   ./rt_scheduler_bench --benchmark_filter=Run/EDF
+//
+// Task sets come from generator.hpp with a fixed seed: UUniFast
+// utilizations, periods log-uniform in [10n, 1000n] so the number of
+// releases per tick stays moderate as n grows, all released at 0.
+// Counters: ticks/s (simulated time per second), allocs and bytes per
+// iteration (every operator new in the timed region, setup excluded).
+
+#include <benchmark/benchmark.h>
+
+#include "factory.hpp"
+#include "parser.hpp"
+#include "generator.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+
+// ---- allocation counting ----
+
+static std::atomic<std::size_t> gAllocs{0};
+static std::atomic<std::size_t> gAllocBytes{0};
+
+// Every replaceable form is defined, so each new pairs with the matching
+// delete: plain, array, nothrow and over-aligned, sized or not.
+static void* countedAlloc(std::size_t size, std::size_t align) {
+    gAllocs.fetch_add(1, std::memory_order_relaxed);
+    gAllocBytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    if (align <= alignof(std::max_align_t)) return std::malloc(size);
+    return std::aligned_alloc(align, (size + align - 1) / align * align);
+}
+
+// GCC's -Wmismatched-new-delete pairs an inlined operator new with the
+// std::free in the replacement operator delete and flags every delete
+// expression, although malloc / aligned_alloc and free do match here.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    if (void *p = countedAlloc(size, 0)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, 0);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, 0);
+}
+void* operator new(std::size_t size, std::align_val_t align) {
+    if (void *p = countedAlloc(size, static_cast<std::size_t>(align))) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return ::operator new(size, align);
+}
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, static_cast<std::size_t>(align));
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+// Allocations made between start() and stop(), summed over iterations
+class AllocCounter {
+    std::size_t allocs_ = 0, bytes_ = 0;
+    std::size_t startAllocs_ = 0, startBytes_ = 0;
+
+public:
+    void start() {
+        startAllocs_ = gAllocs.load();
+        startBytes_ = gAllocBytes.load();
+    }
+    void stop() {
+        allocs_ += gAllocs.load() - startAllocs_;
+        bytes_ += gAllocBytes.load() - startBytes_;
+    }
+    void report(benchmark::State& state) const {
+        state.counters["allocs"] = benchmark::Counter(
+            static_cast<double>(allocs_), benchmark::Counter::kAvgIterations);
+        state.counters["bytes"] = benchmark::Counter(
+            static_cast<double>(bytes_), benchmark::Counter::kAvgIterations);
+    }
+};
+
+// ---- workloads ----
+
+// n tasks, periods in [10n, 1000n], aperiodic Poisson arrivals at `rate`
+// per tick until horizon
+TaskSet makeSet(std::int64_t n, double util, Time horizon = 0, double rate = 0.0) {
+    GeneratorConfig cfg;
+    cfg.tasks = static_cast<std::size_t>(n);
+    cfg.utilization = util;
+    cfg.periodMin = 10 * n;
+    cfg.periodMax = 1000 * n;
+    cfg.aperiodicRate = rate;
+    cfg.horizon = horizon;
+    cfg.seed = 42;
+    return generateTaskSet(cfg);
+}
+
+// ---- benchmarks ----
+
+// Full simulation; args: tasks, utilization %, horizon
+void BM_Run(benchmark::State& state, const char* alg) {
+    auto tasks = makeSet(state.range(0), state.range(1) / 100.0).tasks;
+    Time horizon = state.range(2);
+    AllocCounter allocs;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto sched = buildScheduler(alg, tasks, {}, std::nullopt,
+                                    horizon, ServerRuleConfig{});
+        state.ResumeTiming();
+        allocs.start();
+        sched->run();
+        allocs.stop();
+        benchmark::DoNotOptimize(sched->finished().data());
+        state.PauseTiming();
+        sched.reset();
+        state.ResumeTiming();
+    }
+    allocs.report(state);
+    state.counters["ticks/s"] = benchmark::Counter(
+        static_cast<double>(horizon), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Server schedulers with Poisson aperiodic load; args: tasks, horizon
+void BM_Server(benchmark::State& state, const char* alg) {
+    Time horizon = state.range(1);
+    auto set = makeSet(state.range(0), 0.5, horizon, 0.05);
+    const auto &tasks = set.tasks;
+    const auto &aperiodic = set.aperiodic;
+    ServerCfg cfg{2, 10, 10};
+    AllocCounter allocs;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto sched = buildScheduler(alg, tasks, aperiodic, cfg,
+                                    horizon, ServerRuleConfig{});
+        state.ResumeTiming();
+        allocs.start();
+        sched->run();
+        allocs.stop();
+        benchmark::DoNotOptimize(sched->finished().data());
+        state.PauseTiming();
+        sched.reset();
+        state.ResumeTiming();
+    }
+    allocs.report(state);
+    state.counters["ticks/s"] = benchmark::Counter(
+        static_cast<double>(horizon), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["aperiodic"] = static_cast<double>(aperiodic.size());
+}
+
+// releaseJobs over every tick of the horizon; args: tasks, horizon
+void BM_ReleaseJobs(benchmark::State& state) {
+    auto tasks = makeSet(state.range(0), 0.9).tasks;
+    Time horizon = state.range(1);
+    AllocCounter allocs;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto sched = buildScheduler("EDF", tasks, {}, std::nullopt,
+                                    horizon, ServerRuleConfig{});
+        state.ResumeTiming();
+        allocs.start();
+        for (Time t = 0; t < horizon; ++t) sched->releaseJobs(t);
+        allocs.stop();
+        state.PauseTiming();
+        sched.reset();
+        state.ResumeTiming();
+    }
+    allocs.report(state);
+    state.counters["ticks/s"] = benchmark::Counter(
+        static_cast<double>(horizon), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// chooseJob with every task's first job ready; args: tasks
+void BM_ChooseJob(benchmark::State& state, const char* alg) {
+    auto tasks = makeSet(state.range(0), 0.9).tasks;
+    auto sched = buildScheduler(alg, tasks, {}, std::nullopt,
+                                1000, ServerRuleConfig{});
+    sched->releaseJobs(0);
+    AllocCounter allocs;
+    allocs.start();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sched->chooseJob(0));
+    }
+    allocs.stop();
+    allocs.report(state);
+}
+
+// parseInputFile on a generated file; args: tasks
+void BM_ParseInputFile(benchmark::State& state) {
+    auto set = makeSet(state.range(0), 0.9);
+    set.serverCfg = ServerCfg{2, 10, 10};
+    auto path = std::filesystem::temp_directory_path() /
+                ("rt_scheduler_bench_" + std::to_string(state.range(0)) + ".txt");
+    {
+        std::ofstream out(path);
+        writeTaskSet(out, set);
+    }
+    AllocCounter allocs;
+    allocs.start();
+    for (auto _ : state) {
+        auto parsed = parseInputFile(path.string());
+        benchmark::DoNotOptimize(std::get<0>(parsed).data());
+    }
+    allocs.stop();
+    allocs.report(state);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::filesystem::remove(path);
+}
+
+const std::vector<std::int64_t> kTaskCounts = {10, 100, 1000, 10000, 100000};
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_Run, EDF, "EDF")
+    ->ArgsProduct({kTaskCounts, {50, 90}, {10000, 100000}})
+    ->ArgNames({"tasks", "util", "horizon"})->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Run, RMS, "RMS")
+    ->ArgsProduct({kTaskCounts, {50, 90}, {10000, 100000}})
+    ->ArgNames({"tasks", "util", "horizon"})->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Run, LLF, "LLF")
+    ->ArgsProduct({kTaskCounts, {50, 90}, {10000, 100000}})
+    ->ArgNames({"tasks", "util", "horizon"})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_Server, BACKGROUND, "BACKGROUND")
+    ->ArgsProduct({{10, 1000, 100000}, {10000, 100000}})
+    ->ArgNames({"tasks", "horizon"})->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Server, POLLING, "POLLING")
+    ->ArgsProduct({{10, 1000, 100000}, {10000, 100000}})
+    ->ArgNames({"tasks", "horizon"})->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Server, DEFERRABLE, "DEFERRABLE")
+    ->ArgsProduct({{10, 1000, 100000}, {10000, 100000}})
+    ->ArgNames({"tasks", "horizon"})->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Server, SPORADIC, "SPORADIC")
+    ->ArgsProduct({{10, 1000, 100000}, {10000, 100000}})
+    ->ArgNames({"tasks", "horizon"})->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_ReleaseJobs)
+    ->ArgsProduct({kTaskCounts, {10000}})
+    ->ArgNames({"tasks", "horizon"})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_ChooseJob, EDF, "EDF")->ArgsProduct({kTaskCounts})->ArgNames({"tasks"});
+BENCHMARK_CAPTURE(BM_ChooseJob, LLF, "LLF")->ArgsProduct({kTaskCounts})->ArgNames({"tasks"});
+
+BENCHMARK(BM_ParseInputFile)->ArgsProduct({kTaskCounts})->ArgNames({"tasks"});
+
+BENCHMARK_MAIN();
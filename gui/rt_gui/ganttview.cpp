@@ -0,0 +1,216 @@
+#include "ganttview.h"
+
+#include <QPainter>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Narrowest window, in ticks, the view zooms in to
+constexpr double kMinSpan = 8.0;
+
+// Space around the bars for row names and the time axis
+constexpr int kMarginLeft = 70;
+constexpr int kMarginTop = 24;
+constexpr int kMarginRight = 12;
+constexpr int kMarginBottom = 28;
+
+QColor rowColor(int label, int row, int rows)
+{
+    if (label == Timeline::kIdle) return QColor(90, 94, 102);
+    return QColor::fromHsv(row * 300 / std::max(rows, 1), 160, 235);
+}
+
+// 1, 2 or 5 times a power of ten, at least 1 tick
+Time axisStep(double rawStep)
+{
+    if (rawStep <= 1.0) return 1;
+    double mag = std::pow(10.0, std::floor(std::log10(rawStep)));
+    double f = rawStep / mag;
+    double step = (f <= 1.0 ? 1.0 : f <= 2.0 ? 2.0 : f <= 5.0 ? 5.0 : 10.0) * mag;
+    return static_cast<Time>(std::llround(step));
+}
+
+} // namespace
+
+GanttView::GanttView(QWidget *parent)
+    : QWidget(parent)
+{
+    setMinimumHeight(350);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+}
+
+void GanttView::setTimeline(Timeline timeline)
+{
+    timeline_ = std::move(timeline);
+
+    // Label -> row index, in order of first appearance
+    rowLabels_.clear();
+    rowOfLabel_.assign(timeline_.labels().size() + 1, -1);
+    timeline_.forEachRun([&](const TimelineSegment &s) {
+        int &row = rowOfLabel_[s.label + 1];
+        if (row < 0) {
+            row = static_cast<int>(rowLabels_.size());
+            rowLabels_.push_back(s.label);
+        }
+    });
+
+    resetZoom();
+}
+
+void GanttView::resetZoom()
+{
+    viewStart_ = 0.0;
+    viewEnd_ = static_cast<double>(timeline_.size());
+    update();
+}
+
+QRect GanttView::plotRect() const
+{
+    return rect().adjusted(kMarginLeft, kMarginTop, -kMarginRight, -kMarginBottom);
+}
+
+double GanttView::xOf(double t) const
+{
+    QRect plot = plotRect();
+    return plot.left() + (t - viewStart_) * plot.width() / (viewEnd_ - viewStart_);
+}
+
+double GanttView::timeAt(double x) const
+{
+    QRect plot = plotRect();
+    return viewStart_ + (x - plot.left()) * (viewEnd_ - viewStart_) / plot.width();
+}
+
+void GanttView::setView(double start, double end)
+{
+    double total = static_cast<double>(timeline_.size());
+    double span = std::clamp(end - start, std::min(total, kMinSpan), total);
+    viewStart_ = std::clamp(start, 0.0, total - span);
+    viewEnd_ = viewStart_ + span;
+    update();
+}
+
+void GanttView::paintEvent(QPaintEvent *)
+{
+    QPainter p(this);
+    p.fillRect(rect(), QColor(32, 34, 38));
+
+    QRect plot = plotRect();
+    if (timeline_.empty() || rowLabels_.empty() ||
+        plot.width() <= 0 || plot.height() <= 0) {
+        p.setPen(QColor(160, 160, 160));
+        p.drawText(rect(), Qt::AlignCenter, "No schedule");
+        return;
+    }
+
+    const int rows = static_cast<int>(rowLabels_.size());
+    const double rowHeight = static_cast<double>(plot.height()) / rows;
+    const double span = viewEnd_ - viewStart_;
+
+    // Row names and bands
+    p.setPen(QColor(224, 224, 224));
+    for (int r = 0; r < rows; ++r) {
+        QRectF band(plot.left(), plot.top() + r * rowHeight, plot.width(), rowHeight);
+        if (r % 2) p.fillRect(band, QColor(38, 41, 46));
+        p.drawText(QRectF(0, band.top(), kMarginLeft - 8, rowHeight),
+                   Qt::AlignRight | Qt::AlignVCenter,
+                   QString::fromStdString(timeline_.labelName(rowLabels_[r])));
+    }
+
+    // Time axis, about one label per 80 pixels
+    Time step = axisStep(span * 80.0 / plot.width());
+    Time first = static_cast<Time>(std::ceil(viewStart_ / step)) * step;
+    for (Time t = first; t <= viewEnd_; t += step) {
+        double x = xOf(static_cast<double>(t));
+        p.setPen(QColor(60, 64, 70));
+        p.drawLine(QPointF(x, plot.top()), QPointF(x, plot.bottom()));
+        p.setPen(QColor(200, 200, 200));
+        p.drawText(QRectF(x - 40, plot.bottom() + 4, 80, kMarginBottom - 4),
+                   Qt::AlignHCenter | Qt::AlignTop, QString::number(t));
+    }
+    p.drawText(QRectF(plot.left(), 0, plot.width(), kMarginTop),
+               Qt::AlignRight | Qt::AlignVCenter,
+               QString("[%1, %2)")
+                   .arg(static_cast<qlonglong>(std::floor(viewStart_)))
+                   .arg(static_cast<qlonglong>(std::ceil(viewEnd_))));
+
+    // Bars. A gap shorter than one pixel is invisible, so a row's runs
+    // are merged across it and each row draws at most one bar per pixel.
+    p.setClipRect(plot);
+    const Time slack = static_cast<Time>(span / plot.width());
+    struct Bar { Time start = 0, end = -1; };
+    std::vector<Bar> pending(rows);
+
+    auto flush = [&](int row) {
+        Bar &b = pending[row];
+        if (b.end < 0) return;
+        double x0 = xOf(static_cast<double>(b.start));
+        double x1 = xOf(static_cast<double>(b.end));
+        QRectF bar(x0, plot.top() + (row + 0.2) * rowHeight,
+                   std::max(1.0, x1 - x0), rowHeight * 0.6);
+        QColor color = rowColor(rowLabels_[row], row, rows);
+        p.fillRect(bar, color);
+        if (bar.width() >= 4.0) {
+            p.setPen(color.darker(160));
+            p.drawRect(bar);
+        }
+        b.end = -1;
+    };
+
+    timeline_.forEachRunIn(static_cast<Time>(std::floor(viewStart_)),
+                           static_cast<Time>(std::ceil(viewEnd_)),
+                           [&](const TimelineSegment &s) {
+        int row = rowOfLabel_[s.label + 1];
+        Bar &b = pending[row];
+        if (b.end >= 0 && s.start - b.end <= slack) {
+            b.end = s.start + s.length;
+            return;
+        }
+        flush(row);
+        b.start = s.start;
+        b.end = s.start + s.length;
+    });
+    for (int r = 0; r < rows; ++r) flush(r);
+}
+
+void GanttView::wheelEvent(QWheelEvent *event)
+{
+    if (timeline_.empty()) return;
+
+    // one notch (120) zooms by about 11%, around the time under the cursor
+    double anchor = timeAt(event->position().x());
+    double factor = std::pow(0.999, event->angleDelta().y());
+    setView(anchor - (anchor - viewStart_) * factor,
+            anchor + (viewEnd_ - anchor) * factor);
+    event->accept();
+}
+
+void GanttView::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton) return;
+    dragX_ = event->pos().x();
+    dragViewStart_ = viewStart_;
+    setCursor(Qt::ClosedHandCursor);
+}
+
+void GanttView::mouseMoveEvent(QMouseEvent *event)
+{
+    if (dragX_ < 0 || plotRect().width() <= 0) return;
+    double span = viewEnd_ - viewStart_;
+    double shift = (dragX_ - event->pos().x()) * span / plotRect().width();
+    setView(dragViewStart_ + shift, dragViewStart_ + shift + span);
+}
+
+void GanttView::mouseReleaseEvent(QMouseEvent *)
+{
+    dragX_ = -1;
+    unsetCursor();
+}
+
+void GanttView::mouseDoubleClickEvent(QMouseEvent *)
+{
+    resetZoom();
+}
@@ -0,0 +1,50 @@
+#ifndef GANTTVIEW_H
+#define GANTTVIEW_H
+
+#include <QWidget>
+#include <vector>
+
+#include "../src/timeline.hpp"
+
+// Gantt chart of a Timeline, one row per label.
+// Execution intervals are drawn as bars, and only the visible window is
+// read from the timeline. Runs of a row closer together than one pixel are
+// merged into one bar, so a zoomed-out million-tick schedule costs about
+// as much to draw as a short one.
+// Wheel zooms around the cursor, dragging pans, double-click shows all.
+class GanttView : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit GanttView(QWidget *parent = nullptr);
+
+    void setTimeline(Timeline timeline);
+    void resetZoom();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private:
+    Timeline timeline_;
+    std::vector<int> rowLabels_;    // row -> label id, first appearance order
+    std::vector<int> rowOfLabel_;   // label id + 1 -> row
+
+    // Visible window [viewStart_, viewEnd_) in ticks
+    double viewStart_ = 0.0;
+    double viewEnd_ = 0.0;
+
+    int dragX_ = -1;
+    double dragViewStart_ = 0.0;
+
+    QRect plotRect() const;
+    double xOf(double t) const;
+    double timeAt(double x) const;
+    void setView(double start, double end);
+};
+
+#endif // GANTTVIEW_H
@@ -4,16 +4,15 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QVBoxLayout>
-#include <unordered_map>
+#include <QProgressBar>
+#include <QtConcurrent/QtConcurrentRun>
 
-#include <QtCharts/QChart>
-#include <QtCharts/QScatterSeries>
-#include <QtCharts/QValueAxis>
-#include <QtCharts/QCategoryAxis>
+#include "ganttview.h"
 
 #include "../src/parser.hpp"
 #include "../src/factory.hpp"
 #include "../src/models.hpp"
+#include "../src/trace.hpp"
 
 
 
@@ -69,10 +68,31 @@ MainWindow::MainWindow(QWidget *parent)
             this, &MainWindow::onBrowseFile);
     connect(ui->btnRun, &QPushButton::clicked,
             this, &MainWindow::onRunSimulation);
+    connect(ui->btnLoadTrace, &QPushButton::clicked,
+            this, &MainWindow::onLoadTrace);
+    connect(ui->btnCancel, &QPushButton::clicked,
+            this, &MainWindow::onCancelSimulation);
+    connect(&watcher_, &QFutureWatcher<RunResult>::finished,
+            this, &MainWindow::onSimulationFinished);
+
+    ui->btnCancel->setEnabled(false);
+    ui->progressSim->setRange(0, 100);
+    ui->progressSim->setValue(0);
+
+    // Gantt view fills the chart area
+    gantt_ = new GanttView(ui->chartWidget);
+    auto *layout = new QVBoxLayout(ui->chartWidget);
+    layout->setContentsMargins(4, 4, 4, 4);
+    layout->addWidget(gantt_);
 }
 
 MainWindow::~MainWindow()
 {
+    // the worker still uses the scheduler
+    if (running_) {
+        running_->cancel();
+        watcher_.waitForFinished();
+    }
     delete ui;
 }
 
@@ -103,141 +123,106 @@ void MainWindow::onRunSimulation()
             return;
         }
 
-        int hp = hyperperiod(tasks);
+        Time hp = hyperperiod(tasks);
 
         // Simulation time
-        int sim = ui->lineSim->text().isEmpty()
-                      ? hp
-                      : ui->lineSim->text().toInt();
+        Time sim = ui->lineSim->text().isEmpty()
+                       ? hp
+                       : ui->lineSim->text().toLongLong();
 
         // Algorithm selection
         std::string alg = ui->comboAlg->currentText().toStdString();
 
         // Scheduler
-        ServerRuleConfig rules = loadServerRuleConfig("settings.json");
-        auto scheduler = buildScheduler(alg, tasks, aperiodic, serverCfg, sim);
-
-        // Execute
-        scheduler->run();
-
-        // Textual summary
-        ui->output->setPlainText(
-            QString::fromStdString(scheduler->summaryText())
-            );
-
-        // Draw chart
-        drawTimelineChart(scheduler->timeline());
+        running_ = buildScheduler(alg, tasks, aperiodic, serverCfg, sim);
+
+        // Progress arrives on the worker thread; hand it to the UI thread
+        QProgressBar *bar = ui->progressSim;
+        running_->setProgress([bar](Time now, Time total) {
+            int pct = static_cast<int>(now * 100 / total);
+            QMetaObject::invokeMethod(bar, [bar, pct] { bar->setValue(pct); },
+                                      Qt::QueuedConnection);
+            return true;
+        });
+
+        ui->btnRun->setEnabled(false);
+        ui->btnCancel->setEnabled(true);
+        ui->progressSim->setValue(0);
+        ui->output->setPlainText("Running...");
+
+        // Execute and build the summary off the UI thread
+        PeriodicScheduler *scheduler = running_.get();
+        watcher_.setFuture(QtConcurrent::run([scheduler]() {
+            RunResult r;
+            try {
+                scheduler->run();
+                r.summary = QString::fromStdString(scheduler->summaryText());
+            } catch (const std::exception &e) {
+                r.error = QString::fromUtf8(e.what());
+            }
+            return r;
+        }));
     }
     catch (const std::exception &e) {
         QMessageBox::critical(this, "Runtime Error", e.what());
     }
 }
 
-void MainWindow::drawTimelineChart(const std::vector<std::string>& timeline)
+void MainWindow::onCancelSimulation()
 {
-    if (timeline.empty()) return;
-
-    // Label -> row index
-    std::vector<std::string> labelsOrdered;
-    std::unordered_map<std::string, int> labelToRow;
+    if (running_) running_->cancel();
+}
 
-    for (const auto &label : timeline) {
-        if (labelToRow.find(label) == labelToRow.end()) {
-            int idx = static_cast<int>(labelsOrdered.size());
-            labelsOrdered.push_back(label);
-            labelToRow[label] = idx;
-        }
-    }
+void MainWindow::onSimulationFinished()
+{
+    RunResult r = watcher_.result();
+    ui->btnRun->setEnabled(true);
+    ui->btnCancel->setEnabled(false);
 
-    // Chart
-    auto *chart = new QChart();
-    chart->setTitle("Schedule Timeline");
-    chart->setTitleFont(QFont("SF Pro", 14, QFont::Bold));
-    chart->setAnimationOptions(QChart::SeriesAnimations);
-    chart->legend()->setAlignment(Qt::AlignTop);
-    chart->legend()->setFont(QFont("SF Pro", 10));
-    chart->legend()->setMarkerShape(QLegend::MarkerShapeFromSeries);
-
-    // Series for each task 
-    for (const auto &label : labelsOrdered) {
-        int row = labelToRow[label];
-
-        auto *series = new QScatterSeries();
-        series->setName(QString::fromStdString(label));
-        series->setMarkerShape(QScatterSeries::MarkerShapeCircle);
-        series->setMarkerSize(14.0);                      
-        series->setBorderColor(Qt::black);
-        series->setOpacity(0.9);
-
-        for (int t = 0; t < static_cast<int>(timeline.size()); t++) {
-            if (timeline[t] == label) {
-                series->append(t + 0.5, row);              
-            }
-        }
+    if (!r.error.isEmpty()) {
+        QMessageBox::critical(this, "Runtime Error", r.error);
+    } else {
+        if (!running_->cancelled()) ui->progressSim->setValue(100);
 
-        chart->addSeries(series);
-    }
+        // Textual summary
+        ui->output->setPlainText(r.summary);
 
-    // X axis: time
-    auto *axisX = new QValueAxis();
-    axisX->setTitleText("Time");
-    axisX->setLabelFormat("%d");
-    axisX->setTickInterval(1);
-    axisX->setMinorTickCount(0);
-    axisX->setRange(0, timeline.size());
-    axisX->setGridLineVisible(true);
-    axisX->setGridLinePen(QPen(QColor(220, 220, 220)));
-    chart->addAxis(axisX, Qt::AlignBottom);
-
-    for (auto *s : chart->series())
-        s->attachAxis(axisX);
-
-    //Y axis: tasks
-    auto *axisY = new QCategoryAxis();
-    axisY->setTitleText("Task");
-    axisY->setGridLineVisible(true);
-    axisY->setGridLinePen(QPen(QColor(230, 230, 230)));
-
-    for (auto &label : labelsOrdered) {
-        axisY->append(QString::fromStdString(label), labelToRow[label]);
+        // Gantt chart
+        gantt_->setTimeline(running_->timeline());
     }
+    running_.reset();
+}
 
-    axisY->setRange(-0.5, labelsOrdered.size() - 0.5);
-    chart->addAxis(axisY, Qt::AlignLeft);
+void MainWindow::onLoadTrace()
+{
+    QString file = QFileDialog::getOpenFileName(this, "Select trace file");
+    if (file.isEmpty()) return;
 
-    for (auto *s : chart->series())
-        s->attachAxis(axisY);
+    try {
+        // Mapped, not parsed: only the run records are touched
+        TraceReader trace(file.toStdString());
+        std::size_t finished = 0, missed = 0;
+        for (const auto &r : trace) {
+            auto type = static_cast<TraceEvent>(r.type);
+            if (type == TraceEvent::Complete) ++finished;
+            else if (type == TraceEvent::Miss) ++missed;
+        }
 
-    // Clear old chartView
-    if (chartView_) {
-        delete chartView_;
-        chartView_ = nullptr;
+        ui->output->setPlainText(QString(
+            "=== Trace %1 ===\n"
+            "Records: %2\n"
+            "Simulation time: %3\n"
+            "Finished jobs: %4\n"
+            "Missed deadlines: %5\n")
+            .arg(file)
+            .arg(static_cast<qulonglong>(trace.size()))
+            .arg(trace.simTime())
+            .arg(static_cast<qulonglong>(finished))
+            .arg(static_cast<qulonglong>(missed)));
+
+        gantt_->setTimeline(trace.timeline());
     }
-
-    // New chartView
-    chartView_ = new QChartView(chart, ui->chartWidget);
-    chartView_->setRenderHint(QPainter::Antialiasing);
-    chartView_->setMinimumHeight(350); 
-    chartView_->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-
-    QLayout *oldLayout = ui->chartWidget->layout();
-    if (!oldLayout) {
-        auto *layout = new QVBoxLayout(ui->chartWidget);
-        layout->setContentsMargins(4, 4, 4, 4);
-        layout->addWidget(chartView_);
-    } else {
-        auto *vlayout = qobject_cast<QVBoxLayout*>(oldLayout);
-        if (!vlayout) {
-            delete oldLayout;
-            vlayout = new QVBoxLayout(ui->chartWidget);
-        } else {
-            QLayoutItem *item;
-            while ((item = vlayout->takeAt(0)) != nullptr) {
-                delete item->widget();
-                delete item;
-            }
-        }
-        vlayout->setContentsMargins(4, 4, 4, 4);
-        vlayout->addWidget(chartView_);
+    catch (const std::exception &e) {
+        QMessageBox::critical(this, "Trace Error", e.what());
     }
 }
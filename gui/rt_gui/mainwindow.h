@@ -2,14 +2,25 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
-#include <QtCharts/QChartView>
+#include <QFutureWatcher>
 #include <vector>
 #include <string>
+#include <memory>
+
+#include "../src/sched_base.hpp"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
+class GanttView;
+
+// Outcome of a simulation run on the worker thread
+struct RunResult {
+    QString summary;
+    QString error;      // empty on success
+};
+
 class MainWindow : public QMainWindow {
     Q_OBJECT
 
@@ -20,15 +31,19 @@ public:
 private slots:
     void onBrowseFile();
     void onRunSimulation();
+    void onLoadTrace();
+    void onCancelSimulation();
+    void onSimulationFinished();
 
 private:
     Ui::MainWindow *ui;
 
-    // Chart view pointer
-    QChartView *chartView_ = nullptr;
+    // Gantt chart of the last run or trace
+    GanttView *gantt_ = nullptr;
 
-    // Chart drawing
-    void drawTimelineChart(const std::vector<std::string>& timeline);
+    // Simulation running on the worker thread, if any
+    std::unique_ptr<PeriodicScheduler> running_;
+    QFutureWatcher<RunResult> watcher_;
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,287 @@
+#pragma once
+#include "models.hpp"
+#include <vector>
+#include <string>
+#include <numeric>
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+#include <cctype>
+#include <optional>
+#include <limits>
+
+// Exact schedulability analysis
+// Answers feasibility without simulating a hyperperiod:
+//   RMS / DMS -> response-time analysis (arbitrary deadlines, level-i
+//                busy period), per-task worst-case response times
+//   EDF / LLF -> processor demand criterion checked with QPA
+//                (Zhang & Burns); both are optimal on one processor
+// Tasks are analysed from a synchronous release; with arrival offsets
+// that is the worst case, so a positive answer still holds.
+// A job meets its deadline d by completing at or before d. The simulator
+// only drops a job once t > d, i.e. it still lets the job run during
+// tick d, so simulation is one tick more lenient than this analysis.
+
+struct TaskResponse {
+    std::string name;
+    Time wcrt = -1;             // worst-case response time, -1 = not computed
+    bool schedulable = true;
+};
+
+struct AnalysisResult {
+    std::string policy;
+    std::string method;
+    bool schedulable = true;
+    double utilization = 0.0;
+    std::vector<TaskResponse> tasks;   // per task, in input order
+    Time failureAt = -1;               // EDF: a deadline where demand > time
+};
+
+inline double utilization(const std::vector<PeriodicTask>& tasks) {
+    double u = 0.0;
+    for (const auto &t : tasks) u += static_cast<double>(t.execTime) / t.period;
+    return u;
+}
+
+// a * b for non-negative a, b, nullopt if it does not fit in Time
+inline std::optional<Time> checkedProduct(Time a, Time b) {
+    if (a != 0 && b > std::numeric_limits<Time>::max() / a) return std::nullopt;
+    return a * b;
+}
+
+// Sign of U - 1, U the utilization of tasks, decided exactly so that full
+// sets (e.g. three tasks at 1/3) are neither over nor under 1. U is summed
+// as a reduced fraction; only if its denominator overflows 64 bits does
+// this fall back to long double.
+inline int compareUtilizationToOne(const std::vector<PeriodicTask>& tasks) {
+    Time num = 0, den = 1;
+    bool exact = true;
+    for (const auto &t : tasks) {
+        auto l = lcm(den, t.period);
+        auto a = l ? checkedProduct(num, *l / den) : std::nullopt;
+        auto b = l ? checkedProduct(t.execTime, *l / t.period) : std::nullopt;
+        if (!a || !b || *a > std::numeric_limits<Time>::max() - *b) {
+            exact = false;
+            break;
+        }
+        num = *a + *b;
+        den = *l;
+        Time g = std::gcd(num, den);
+        num /= g;
+        den /= g;
+        if (num > den) return 1;   // the sum only grows
+    }
+    if (exact) return num < den ? -1 : (num > den ? 1 : 0);
+
+    long double u = 0.0L;
+    for (const auto &t : tasks) u += static_cast<long double>(t.execTime) / t.period;
+    return u < 1.0L ? -1 : (u > 1.0L ? 1 : 0);
+}
+
+// Worst-case response time of tasks[i] under fixed priorities, where
+// higher[] lists the tasks that can preempt it (their utilization with
+// task i must not exceed 1).
+// Stops and returns a value above the deadline as soon as it is exceeded.
+inline Time responseTime(const std::vector<PeriodicTask>& tasks,
+                         std::size_t i,
+                         const std::vector<std::size_t>& higher)
+{
+    const auto &ti = tasks[i];
+    auto interference = [&](Time w) {
+        Time sum = 0;
+        for (std::size_t j : higher) {
+            sum += (w + tasks[j].period - 1) / tasks[j].period * tasks[j].execTime;
+        }
+        return sum;
+    };
+
+    // level-i busy period: every job of i inside it has to be checked
+    Time busy = ti.execTime;
+    for (std::size_t j : higher) busy += tasks[j].execTime;
+    while (true) {
+        Time next = (busy + ti.period - 1) / ti.period * ti.execTime
+                       + interference(busy);
+        if (next == busy) break;
+        busy = next;
+    }
+
+    Time worst = 0;
+    Time jobs = (busy + ti.period - 1) / ti.period;
+    for (Time q = 0; q < std::max<Time>(jobs, 1); ++q) {
+        Time w = (q + 1) * ti.execTime;
+        while (true) {
+            Time next = (q + 1) * ti.execTime + interference(w);
+            if (next == w) break;
+            w = next;
+            if (w - q * ti.period > ti.deadline) break;   // already too late
+        }
+        worst = std::max(worst, w - q * ti.period);
+        if (worst > ti.deadline) break;
+    }
+    return worst;
+}
+
+// RMS (by period) or DMS (by deadline).
+// Equal priorities are served in release order and simultaneous releases
+// in task order, as the simulator's ready queue does. A tied task j after
+// i therefore only delays i if one of its jobs can be released before
+// i's; tasks with the same arrival and period, whose jobs meet their
+// deadline before the next release (D <= T), never are and interfere in
+// task order only. Other ties are counted both ways, which is safe.
+inline AnalysisResult analyzeFixedPriority(const std::vector<PeriodicTask>& tasks,
+                                           bool byDeadline)
+{
+    AnalysisResult res;
+    res.policy = byDeadline ? "DMS" : "RMS";
+    res.method = "response-time analysis";
+    res.utilization = utilization(tasks);
+
+    auto prio = [&](const PeriodicTask& t) {
+        return byDeadline ? t.deadline : t.period;
+    };
+
+    auto lockstep = [&](const PeriodicTask& a, const PeriodicTask& b) {
+        return a.arrival == b.arrival && a.period == b.period &&
+               a.deadline <= a.period && b.deadline <= b.period;
+    };
+    auto interferes = [&](std::size_t j, std::size_t i) {
+        if (prio(tasks[j]) != prio(tasks[i])) return prio(tasks[j]) < prio(tasks[i]);
+        return j < i || !lockstep(tasks[j], tasks[i]);
+    };
+
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        std::vector<std::size_t> higher;
+        std::vector<PeriodicTask> level{tasks[i]};
+        for (std::size_t j = 0; j < tasks.size(); ++j) {
+            if (j != i && interferes(j, i)) {
+                higher.push_back(j);
+                level.push_back(tasks[j]);
+            }
+        }
+        TaskResponse r;
+        r.name = tasks[i].name;
+
+        // the level-i busy period only ends if these tasks fit
+        if (compareUtilizationToOne(level) > 0) {
+            r.schedulable = false;
+        } else {
+            r.wcrt = responseTime(tasks, i, higher);
+            r.schedulable = r.wcrt <= tasks[i].deadline;
+        }
+        res.schedulable = res.schedulable && r.schedulable;
+        res.tasks.push_back(r);
+    }
+    return res;
+}
+
+// Processor demand h(t): work of all jobs released and due within [0, t]
+inline Time processorDemand(const std::vector<PeriodicTask>& tasks, Time t) {
+    Time h = 0;
+    for (const auto &ti : tasks) {
+        if (t < ti.deadline) continue;
+        h += ((t - ti.deadline) / ti.period + 1) * ti.execTime;
+    }
+    return h;
+}
+
+// Largest absolute deadline strictly before t, -1 if none
+inline Time lastDeadlineBefore(const std::vector<PeriodicTask>& tasks, Time t) {
+    Time best = -1;
+    for (const auto &ti : tasks) {
+        if (t <= ti.deadline) continue;
+        Time k = (t - ti.deadline - 1) / ti.period;
+        best = std::max(best, k * ti.period + ti.deadline);
+    }
+    return best;
+}
+
+inline AnalysisResult analyzeEDF(const std::vector<PeriodicTask>& tasks,
+                                 const std::string& policy = "EDF")
+{
+    AnalysisResult res;
+    res.policy = policy;
+    res.method = "processor demand (QPA)";
+    res.utilization = utilization(tasks);
+    for (const auto &t : tasks) res.tasks.push_back({t.name, -1, true});
+
+    auto fail = [&](Time at) {
+        res.schedulable = false;
+        res.failureAt = at;
+        for (auto &r : res.tasks) r.schedulable = false;
+        return res;
+    };
+
+    if (tasks.empty()) return res;
+    int full = compareUtilizationToOne(tasks);
+    if (full > 0) return fail(-1);
+
+    bool implicit = std::all_of(tasks.begin(), tasks.end(),
+        [](const PeriodicTask& t){ return t.deadline >= t.period; });
+    if (implicit) return res;
+
+    // synchronous busy period bounds the interval to check
+    Time busy = 0;
+    for (const auto &t : tasks) busy += t.execTime;
+    while (true) {
+        Time next = 0;
+        for (const auto &t : tasks) {
+            next += (busy + t.period - 1) / t.period * t.execTime;
+        }
+        if (next == busy) break;
+        busy = next;
+    }
+    Time bound = busy;
+    if (full < 0 && res.utilization < 1.0) {
+        Time maxD = 0;
+        double slack = 0.0;
+        for (const auto &t : tasks) {
+            maxD = std::max<Time>(maxD, t.deadline);
+            slack += static_cast<double>(t.period - t.deadline) * t.execTime / t.period;
+        }
+        Time la = std::max<Time>(
+            maxD, static_cast<Time>(slack / (1.0 - res.utilization)) + 1);
+        bound = std::min(bound, la);
+    }
+
+    Time dMin = tasks.front().deadline;
+    for (const auto &t : tasks) dMin = std::min<Time>(dMin, t.deadline);
+
+    Time t = lastDeadlineBefore(tasks, bound + 1);
+    if (t < 0) return res;
+    Time h = processorDemand(tasks, t);
+    while (h <= t && h > dMin) {
+        if (h < t) t = h;
+        else t = lastDeadlineBefore(tasks, t);
+        if (t < 0) return res;
+        h = processorDemand(tasks, t);
+    }
+    if (h > t) return fail(t);
+    return res;
+}
+
+inline AnalysisResult analyze(const std::string& algName,
+                              const std::vector<PeriodicTask>& tasks)
+{
+    std::string name = algName;
+    for (auto &c : name) c = std::toupper(c);
+
+    if (name == "RMS") return analyzeFixedPriority(tasks, false);
+    if (name == "DMS") return analyzeFixedPriority(tasks, true);
+    if (name == "EDF" || name == "LLF") return analyzeEDF(tasks, name);
+
+    throw std::runtime_error("No analysis for algorithm: " + algName);
+}
+
+inline void writeAnalysis(std::ostream& out, const AnalysisResult& res) {
+    out << "=== Analysis (" << res.policy << ", " << res.method << ") ===\n";
+    out << "Utilization: " << res.utilization << "\n";
+    out << "Schedulable: " << (res.schedulable ? "yes" : "no") << "\n";
+    if (res.failureAt >= 0) {
+        out << "Demand exceeds time at t = " << res.failureAt << "\n";
+    }
+    for (const auto &r : res.tasks) {
+        out << "  " << r.name;
+        if (r.wcrt >= 0) out << " : R = " << r.wcrt;
+        out << (r.schedulable ? "" : " (miss)") << "\n";
+    }
+}
@@ -3,6 +3,7 @@
 #include "policies.hpp"
 #include "sched_base.hpp"
 #include "sched_servers.hpp"
+#include "sched_multi.hpp"
 #include "server_rules.hpp"
 #include <memory>
 #include <cctype>
@@ -12,20 +13,28 @@ inline std::unique_ptr<PeriodicScheduler> buildScheduler(
     const std::vector<PeriodicTask>& tasks,
     const std::vector<AperiodicJob>& aperiodic,
     const std::optional<ServerCfg>& serverCfg,
-    int simTime)
+    Time simTime,
+    const ServerRuleConfig& rules)
 {
     std::string name = algName;
     for (auto &c : name) c = std::toupper(c);
 
-    // Read server rules from settings.json
-    ServerRuleConfig rules = loadServerRuleConfig("settings.json");
-
-    // Pure periodic 
-    if (name == "RMS" || name == "DMS" || name == "EDF" || name == "LLF") {
-        auto policy = makePolicy(name);
+    // Pure periodic, policy fixed at compile time
+    if (name == "RMS") {
         return std::unique_ptr<PeriodicScheduler>(
-            new PeriodicScheduler(tasks, simTime, std::move(policy))
-        );
+            new PeriodicSchedulerT<RMSKey>(tasks, simTime));
+    }
+    if (name == "DMS") {
+        return std::unique_ptr<PeriodicScheduler>(
+            new PeriodicSchedulerT<DMSKey>(tasks, simTime));
+    }
+    if (name == "EDF") {
+        return std::unique_ptr<PeriodicScheduler>(
+            new PeriodicSchedulerT<EDFKey>(tasks, simTime));
+    }
+    if (name == "LLF") {
+        return std::unique_ptr<PeriodicScheduler>(
+            new PeriodicSchedulerT<LLFKey>(tasks, simTime));
     }
 
     // Background 
@@ -74,4 +83,33 @@ inline std::unique_ptr<PeriodicScheduler> buildScheduler(
     }
 
     throw std::runtime_error("Unknown algorithm: " + algName);
-}
\ No newline at end of file
+}
+
+// Same, with server rules read from settings.json
+inline std::unique_ptr<PeriodicScheduler> buildScheduler(
+    const std::string& algName,
+    const std::vector<PeriodicTask>& tasks,
+    const std::vector<AperiodicJob>& aperiodic,
+    const std::optional<ServerCfg>& serverCfg,
+    Time simTime)
+{
+    ServerRuleConfig rules = loadServerRuleConfig("settings.json");
+    return buildScheduler(algName, tasks, aperiodic, serverCfg, simTime, rules);
+}
+
+// Global scheduling of the periodic tasks on `cores` processors
+inline std::unique_ptr<PeriodicScheduler> buildGlobalScheduler(
+    const std::string& algName,
+    const std::vector<PeriodicTask>& tasks,
+    Time simTime,
+    int cores)
+{
+    std::string name = algName;
+    for (auto &c : name) c = std::toupper(c);
+
+    if (name != "RMS" && name != "DMS" && name != "EDF" && name != "LLF") {
+        throw std::runtime_error(algName + " is not available on multiple cores");
+    }
+    return std::unique_ptr<PeriodicScheduler>(
+        new GlobalScheduler(tasks, simTime, cores, makePolicy(name)));
+}
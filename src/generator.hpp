@@ -0,0 +1,352 @@
+#pragma once
+#include "models.hpp"
+#include "analysis.hpp"
+#include <vector>
+#include <string>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <ostream>
+#include <algorithm>
+#include <cmath>
+#include <cctype>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+// Synthetic task sets, generated in memory from a seed
+// Utilizations come from UUniFast (Bini & Buttazzo), UUniFast-discard or
+// RandFixedSum (Stafford; Emberson et al.) for totals above 1 on several
+// cores. Periods are log-uniform, deadlines constrained, and aperiodic jobs
+// arrive as a Poisson process.
+
+enum class UtilMethod {
+    UUniFast,           // total <= 1; individual u_i unbounded above 1 otherwise
+    UUniFastDiscard,    // UUniFast, redrawn until every u_i <= 1
+    RandFixedSum        // uniform over {u_i in [0, 1], sum = total}
+};
+
+struct GeneratorConfig {
+    std::size_t tasks = 10;
+    double utilization = 0.5;           // total, may exceed 1 (multicore)
+    UtilMethod method = UtilMethod::UUniFast;
+    Time periodMin = 0;                 // periods log-uniform in [min, max],
+    Time periodMax = 0;                 // 0 = 10 * tasks / 1000 * tasks
+    Time periodGranularity = 1;         // periods rounded to a multiple
+    double deadlineMin = 1.0;           // D uniform in [max(C, dmin * T), T]
+    double aperiodicRate = 0.0;         // aperiodic arrivals per tick
+    Time aperiodicExecMin = 1;
+    Time aperiodicExecMax = 5;
+    Time horizon = 0;                   // aperiodic arrivals before this,
+                                        // 0 = longest period
+    std::optional<ServerCfg> server;
+    double tolerance = 0.05;            // max relative deviation of the
+                                        // achieved utilization, 0 = unchecked
+    std::uint64_t seed = 1;
+};
+
+struct TaskSet {
+    std::vector<PeriodicTask> tasks;
+    std::vector<AperiodicJob> aperiodic;
+    std::optional<ServerCfg> serverCfg;
+};
+
+// n utilizations summing to total (Bini & Buttazzo)
+inline std::vector<double> uunifast(std::size_t n, double total, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<double> u(n);
+    double sum = total;
+    for (std::size_t i = 1; i < n; ++i) {
+        double next = sum * std::pow(uniform(rng), 1.0 / static_cast<double>(n - i));
+        u[i - 1] = sum - next;
+        sum = next;
+    }
+    if (n > 0) u[n - 1] = sum;
+    return u;
+}
+
+// UUniFast, retried until no task exceeds a whole processor
+inline std::vector<double> uunifastDiscard(std::size_t n, double total,
+                                           std::mt19937_64& rng)
+{
+    constexpr int kMaxAttempts = 100000;
+    for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+        auto u = uunifast(n, total, rng);
+        if (std::all_of(u.begin(), u.end(), [](double x) { return x <= 1.0; })) {
+            return u;
+        }
+    }
+    throw std::runtime_error("UUniFast-discard found no task set with every u_i <= 1; "
+                             "use randfixedsum for totals close to the task count");
+}
+
+// n values in [0, 1] summing to total, uniformly distributed over that
+// simplex slice (Stafford's randfixedsum)
+inline std::vector<double> randFixedSum(std::size_t n, double total, std::mt19937_64& rng) {
+    if (n == 0) return {};
+    const double dn = static_cast<double>(n);
+    if (total < 0.0 || total > dn) {
+        throw std::runtime_error("RandFixedSum needs 0 <= utilization <= task count");
+    }
+    if (n == 1) return {total};
+
+    // total == n would index one past the table; every u_i is 1 then
+    int k = static_cast<int>(std::min(std::floor(total), dn - 1.0));
+    const int ni = static_cast<int>(n);
+
+    std::vector<double> s1(n), s2(n);
+    for (int i = 0; i < ni; ++i) {
+        s1[i] = total - (k - i);
+        s2[i] = (k + ni - i) - total;
+    }
+
+    // w[i][m]: volume terms; t[i][m]: transition probabilities
+    const double tiny = std::numeric_limits<double>::min();
+    std::vector<std::vector<double>> w(n, std::vector<double>(n + 1, 0.0));
+    std::vector<std::vector<double>> t(n - 1, std::vector<double>(n, 0.0));
+    w[0][1] = std::numeric_limits<double>::max();
+    for (int i = 2; i <= ni; ++i) {
+        for (int m = 0; m < i; ++m) {
+            double a = w[i - 2][m + 1] * s1[m] / i;
+            double b = w[i - 2][m] * s2[ni - i + m] / i;
+            w[i - 1][m + 1] = a + b;
+            double sum = w[i - 1][m + 1] + tiny;
+            t[i - 2][m] = s2[ni - i + m] > s1[m] ? b / sum : 1.0 - a / sum;
+        }
+    }
+
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<double> x(n);
+    double s = total, sm = 0.0, pr = 1.0;
+    int j = k + 1;
+    for (int i = ni - 1; i >= 1; --i) {
+        int e = uniform(rng) <= t[i - 1][j - 1] ? 1 : 0;
+        double sx = std::pow(uniform(rng), 1.0 / i);
+        sm += (1.0 - sx) * pr * s / (i + 1);
+        pr *= sx;
+        x[ni - i - 1] = sm + pr * e;
+        s -= e;
+        j -= e;
+    }
+    x[n - 1] = sm + pr * s;
+    std::shuffle(x.begin(), x.end(), rng);
+    return x;
+}
+
+inline UtilMethod parseUtilMethod(const std::string& s) {
+    std::string name = s;
+    for (auto &c : name) c = std::tolower(c);
+    if (name == "uunifast") return UtilMethod::UUniFast;
+    if (name == "uunifast-discard") return UtilMethod::UUniFastDiscard;
+    if (name == "randfixedsum") return UtilMethod::RandFixedSum;
+    throw std::runtime_error("Unknown utilization method: " + s);
+}
+
+inline const char* utilMethodName(UtilMethod m) {
+    switch (m) {
+        case UtilMethod::UUniFast:        return "uunifast";
+        case UtilMethod::UUniFastDiscard: return "uunifast-discard";
+        case UtilMethod::RandFixedSum:    return "randfixedsum";
+    }
+    return "?";
+}
+
+// Period range of cfg with the defaults filled in. Scaling them with the
+// task count keeps the typical share u_i * p_i of a task at several ticks.
+inline std::pair<Time, Time> periodRange(const GeneratorConfig& cfg) {
+    Time n = static_cast<Time>(cfg.tasks);
+    return {cfg.periodMin > 0 ? cfg.periodMin : 10 * n,
+            cfg.periodMax > 0 ? cfg.periodMax : 1000 * n};
+}
+
+// Execution times are rounded to whole ticks, at least 1. A task whose
+// share u_i * p_i is below half a tick is therefore pushed up to a whole
+// one, and with many tasks on short periods the set can end up far above
+// cfg.utilization. The achieved utilization is checked against
+// cfg.tolerance; a set outside it is rejected.
+inline TaskSet generateTaskSet(const GeneratorConfig& cfg) {
+    if (cfg.tasks == 0) throw std::runtime_error("Generator needs at least one task");
+    if (cfg.utilization <= 0.0) throw std::runtime_error("Utilization must be > 0");
+    auto [periodMin, periodMax] = periodRange(cfg);
+    if (cfg.periodMin < 0 || cfg.periodMax < 0 || periodMax < periodMin) {
+        throw std::runtime_error("Periods must satisfy 0 < min <= max");
+    }
+    if (cfg.tolerance < 0.0) throw std::runtime_error("Utilization tolerance cannot be negative");
+    if (cfg.periodGranularity <= 0) throw std::runtime_error("Period granularity must be > 0");
+    if (cfg.deadlineMin <= 0.0 || cfg.deadlineMin > 1.0) {
+        throw std::runtime_error("Minimum deadline ratio must be in (0, 1]");
+    }
+    if (cfg.aperiodicRate < 0.0) throw std::runtime_error("Aperiodic rate cannot be negative");
+    if (cfg.aperiodicExecMin <= 0 || cfg.aperiodicExecMax < cfg.aperiodicExecMin) {
+        throw std::runtime_error("Aperiodic execution times must satisfy 0 < min <= max");
+    }
+
+    std::mt19937_64 rng(cfg.seed);
+    std::vector<double> u;
+    switch (cfg.method) {
+        case UtilMethod::UUniFast:        u = uunifast(cfg.tasks, cfg.utilization, rng); break;
+        case UtilMethod::UUniFastDiscard: u = uunifastDiscard(cfg.tasks, cfg.utilization, rng); break;
+        case UtilMethod::RandFixedSum:    u = randFixedSum(cfg.tasks, cfg.utilization, rng); break;
+    }
+
+    TaskSet set;
+    set.tasks.reserve(cfg.tasks);
+    std::uniform_real_distribution<double> logPeriod(
+        std::log(static_cast<double>(periodMin)),
+        std::log(static_cast<double>(periodMax) + 1.0));
+    Time g = cfg.periodGranularity;
+    Time longest = 0;
+    for (std::size_t i = 0; i < cfg.tasks; ++i) {
+        Time p = static_cast<Time>(std::exp(logPeriod(rng)));
+        p = std::clamp(p, periodMin, periodMax);
+        p = std::max(g, p / g * g);
+        Time e = std::clamp<Time>(std::llround(u[i] * p), 1, p);
+        Time lo = std::max<Time>(e, static_cast<Time>(std::ceil(cfg.deadlineMin * p)));
+        Time d = lo >= p ? p : std::uniform_int_distribution<Time>(lo, p)(rng);
+        set.tasks.push_back({"T" + std::to_string(i + 1), 0, e, p, d});
+        longest = std::max(longest, p);
+    }
+
+    double achieved = utilization(set.tasks);
+    if (cfg.tolerance > 0.0 &&
+        std::abs(achieved - cfg.utilization) > cfg.tolerance * cfg.utilization) {
+        std::ostringstream msg;
+        msg << "Generated utilization " << achieved << " is off the requested "
+            << cfg.utilization << " by more than " << cfg.tolerance * 100
+            << "%: execution times are whole ticks, so use longer periods"
+               " (periods=MIN:MAX) or a larger tolerance";
+        throw std::runtime_error(msg.str());
+    }
+
+    if (cfg.aperiodicRate > 0.0) {
+        Time horizon = cfg.horizon > 0 ? cfg.horizon : longest;
+        std::exponential_distribution<double> gap(cfg.aperiodicRate);
+        std::uniform_int_distribution<Time> exec(cfg.aperiodicExecMin, cfg.aperiodicExecMax);
+        for (double t = gap(rng); t < static_cast<double>(horizon); t += gap(rng)) {
+            Time e = exec(rng);
+            set.aperiodic.push_back({"A" + std::to_string(set.aperiodic.size() + 1),
+                                     static_cast<Time>(t), e, e});
+        }
+    }
+    set.serverCfg = cfg.server;
+    return set;
+}
+
+// Short name of a generated set, e.g. "gen(uunifast n=10 u=0.5 seed=1)"
+inline std::string describe(const GeneratorConfig& cfg) {
+    std::ostringstream os;
+    os << "gen(" << utilMethodName(cfg.method) << " n=" << cfg.tasks
+       << " u=" << cfg.utilization << " seed=" << cfg.seed << ")";
+    return os.str();
+}
+
+// key=value[,key=value...] as taken by --generate:
+//   n, u, method (uunifast | uunifast-discard | randfixedsum),
+//   periods=MIN:MAX, granularity, deadline (minimum D/T), aperiodic (rate),
+//   exec=MIN:MAX (aperiodic), horizon, server=Q:T[:D], tolerance, seed,
+//   count (sets with seeds seed, seed+1, ...)
+inline std::vector<GeneratorConfig> parseGeneratorSpec(const std::string& spec) {
+    GeneratorConfig cfg;
+    std::size_t count = 1;
+
+    auto number = [](const std::string& key, const std::string& v) {
+        try {
+            std::size_t used = 0;
+            double x = std::stod(v, &used);
+            if (used != v.size()) throw std::invalid_argument(v);
+            return x;
+        } catch (const std::exception&) {
+            throw std::runtime_error("Invalid value for " + key + ": " + v);
+        }
+    };
+    auto integer = [&](const std::string& key, const std::string& v) {
+        double x = number(key, v);
+        if (x != std::floor(x)) throw std::runtime_error("Invalid value for " + key + ": " + v);
+        return static_cast<Time>(x);
+    };
+    auto range = [&](const std::string& key, const std::string& v) {
+        auto colon = v.find(':');
+        if (colon == std::string::npos) {
+            throw std::runtime_error(key + " must be MIN:MAX");
+        }
+        return std::make_pair(integer(key, v.substr(0, colon)),
+                              integer(key, v.substr(colon + 1)));
+    };
+
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        auto eq = item.find('=');
+        if (eq == std::string::npos) {
+            throw std::runtime_error("Generator option must be key=value: " + item);
+        }
+        std::string key = item.substr(0, eq), v = item.substr(eq + 1);
+        if (key == "n") {
+            Time n = integer(key, v);
+            if (n <= 0) throw std::runtime_error("Generator needs at least one task");
+            cfg.tasks = static_cast<std::size_t>(n);
+        } else if (key == "u") {
+            cfg.utilization = number(key, v);
+        } else if (key == "method") {
+            cfg.method = parseUtilMethod(v);
+        } else if (key == "periods") {
+            std::tie(cfg.periodMin, cfg.periodMax) = range(key, v);
+            if (cfg.periodMin <= 0 || cfg.periodMax < cfg.periodMin) {
+                throw std::runtime_error("Periods must satisfy 0 < min <= max");
+            }
+        } else if (key == "granularity") {
+            cfg.periodGranularity = integer(key, v);
+        } else if (key == "deadline") {
+            cfg.deadlineMin = number(key, v);
+        } else if (key == "aperiodic") {
+            cfg.aperiodicRate = number(key, v);
+        } else if (key == "exec") {
+            std::tie(cfg.aperiodicExecMin, cfg.aperiodicExecMax) = range(key, v);
+        } else if (key == "horizon") {
+            cfg.horizon = integer(key, v);
+        } else if (key == "server") {
+            std::vector<Time> q;
+            std::stringstream parts(v);
+            std::string part;
+            while (std::getline(parts, part, ':')) q.push_back(integer(key, part));
+            if (q.size() != 2 && q.size() != 3) {
+                throw std::runtime_error("server must be Q:T or Q:T:D");
+            }
+            if (q[0] <= 0 || q[1] <= 0 || (q.size() == 3 && q[2] <= 0)) {
+                throw std::runtime_error("Server budget, period and deadline must be > 0");
+            }
+            cfg.server = ServerCfg{q[0], q[1], q.size() == 3 ? q[2] : q[1]};
+        } else if (key == "tolerance") {
+            cfg.tolerance = number(key, v);
+        } else if (key == "seed") {
+            cfg.seed = static_cast<std::uint64_t>(integer(key, v));
+        } else if (key == "count") {
+            Time c = integer(key, v);
+            if (c <= 0) throw std::runtime_error("count must be >= 1");
+            count = static_cast<std::size_t>(c);
+        } else {
+            throw std::runtime_error("Unknown generator option: " + key);
+        }
+    }
+
+    std::vector<GeneratorConfig> out(count, cfg);
+    for (std::size_t i = 0; i < count; ++i) out[i].seed = cfg.seed + i;
+    return out;
+}
+
+// The P / A / D input format read by parseInputFile
+inline void writeTaskSet(std::ostream& out, const TaskSet& set) {
+    for (const auto &t : set.tasks) {
+        out << "P " << t.arrival << ' ' << t.execTime << ' '
+            << t.period << ' ' << t.deadline << '\n';
+    }
+    for (const auto &a : set.aperiodic) {
+        out << "A " << a.releaseTime << ' ' << a.execTime << '\n';
+    }
+    if (set.serverCfg) {
+        out << "D " << set.serverCfg->Q << ' ' << set.serverCfg->T << ' '
+            << set.serverCfg->D << '\n';
+    }
+}
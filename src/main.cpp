@@ -1,68 +1,552 @@
 #include <iostream>
 #include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <atomic>
+#include <csignal>
+#include <algorithm>
 
 #include "models.hpp"
 #include "parser.hpp"
 #include "factory.hpp"
+#include "sweep.hpp"
+#include "analysis.hpp"
+#include "partition.hpp"
+#include "generator.hpp"
 
-int main() {
-    try {
-        std::string path;
-        std::cout << "Input file path: ";
-        std::getline(std::cin, path);
+// Command line options for batch mode
+struct CliOptions {
+    std::vector<std::string> inputs;
+    std::vector<GeneratorConfig> generated;  // task sets after the files
+    std::string saveGenerated;       // write generated sets here, empty = no
+    std::vector<std::string> algorithms;
+    std::vector<Time> simTimes;      // 0 = hyperperiod, else ticks
+    TimeBase timeBase;               // applied to the input values
+    Engine engine = Engine::Event;
+    Time llfQuantum = 1;             // minimum LLF quantum, 1 = off
+    int cores = 1;                   // > 1: global multiprocessor mode
+    std::optional<PackHeuristic> partition;   // set: partitioned instead
+    Admission admission = Admission::Utilization;
+    bool sweep = false;
+    bool analyze = false;            // print schedulability analysis
+    bool simulate = true;
+    SummaryOptions summary;
+    std::string output;              // empty = stdout
+    std::string trace;               // binary trace path, empty = none
+    std::string stats;               // JSON Lines stats path, empty = none
+    bool progress = false;           // report run progress on stderr
+    unsigned threads = std::thread::hardware_concurrency();
+};
+
+static void printUsage(std::ostream& out) {
+    out << "Usage:\n"
+        << "  rt_scheduler                      interactive mode\n"
+        << "  rt_scheduler --input FILE[,FILE...] --alg ALG[,ALG...] [options]\n"
+        << "  rt_scheduler --generate SPEC --save-generated FILE\n"
+        << "\n"
+        << "Options:\n"
+        << "  --input LIST        comma separated task set files\n"
+        << "  --alg LIST          comma separated algorithms:\n"
+        << "                        EDF, RMS, DMS, LLF, BACKGROUND,\n"
+        << "                        POLLING, DEFERRABLE, SPORADIC\n"
+        << "  --generate SPEC     add generated task sets to the inputs; SPEC is\n"
+        << "                      key=value[,key=value...] with keys\n"
+        << "                        n, u, method (uunifast, uunifast-discard,\n"
+        << "                        randfixedsum), periods=MIN:MAX (default\n"
+        << "                        10n:1000n), granularity, deadline (min D/T),\n"
+        << "                        aperiodic (arrivals per tick), exec=MIN:MAX,\n"
+        << "                        horizon, server=Q:T[:D], tolerance (max\n"
+        << "                        relative utilization error, default 0.05,\n"
+        << "                        0 = off), seed, count (sets with seeds seed,\n"
+        << "                        seed+1...)\n"
+        << "                      needs an explicit --time\n"
+        << "  --save-generated F  write the generated sets in the input format\n"
+        << "                      (F.1, F.2, ... when there are several);\n"
+        << "                      without --alg nothing is simulated\n"
+        << "  --time LIST         simulation times, 0 = hyperperiod (default)\n"
+        << "  --time-base B       ticks per input time unit, or auto to pick\n"
+        << "                      the finest one the input decimals need\n"
+        << "                      (default 1: values rounded to integers)\n"
+        << "  --cores M           schedule globally on M processors\n"
+        << "                      (EDF, RMS, DMS, LLF only)\n"
+        << "  --partition H       partition the tasks onto the --cores instead:\n"
+        << "                      FFD, BFD or WFD (first/best/worst fit\n"
+        << "                      decreasing), one scheduler per core\n"
+        << "  --admission A       per-core admission test for --partition:\n"
+        << "                      util (default) or rta (exact analysis)\n"
+        << "  --llf-quantum Q     LLF: a dispatched job runs at least Q ticks\n"
+        << "                      before LLF may switch (default 1; not with\n"
+        << "                      global --cores)\n"
+        << "  --engine E          event (default) or tick\n"
+        << "  --no-timeline       leave out the per-tick timeline section\n"
+        << "  --no-gantt          leave out the Gantt line\n"
+        << "  --output FILE       write the reports to FILE instead of stdout\n"
+        << "  --trace FILE        write a binary event trace per run\n"
+        << "                      (FILE.1, FILE.2, ... when there are several;\n"
+        << "                      single core only)\n"
+        << "  --stats FILE        append hot-path counters and phase timings of\n"
+        << "                      each run to FILE, one JSON object per line\n"
+        << "                      (builds with RT_SCHED_STATS only)\n"
+        << "  --analyze           also print schedulability analysis\n"
+        << "                      (RTA for RMS/DMS, QPA for EDF/LLF)\n"
+        << "  --analyze-only      print the analysis without simulating\n"
+        << "  --sweep             run all combinations in parallel and print\n"
+        << "                      one CSV row per run instead of summaries\n"
+        << "                      (not with --partition, --trace, --analyze,\n"
+        << "                      --progress, --no-timeline or --no-gantt)\n"
+        << "  --threads N         sweep worker threads (default: all cores)\n"
+        << "  --progress          show run progress on stderr; Ctrl-C stops\n"
+        << "                      the current run and prints its partial report\n"
+        << "  --help              show this text\n";
+}
+
+static std::vector<std::string> splitList(const std::string& s) {
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) out.push_back(item);
+    }
+    return out;
+}
+
+static CliOptions parseArgs(int argc, char** argv) {
+    CliOptions opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("Missing value for " + arg);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--input") {
+            for (auto &f : splitList(value())) opt.inputs.push_back(f);
+        } else if (arg == "--generate") {
+            for (auto &g : parseGeneratorSpec(value())) opt.generated.push_back(g);
+        } else if (arg == "--save-generated") {
+            opt.saveGenerated = value();
+        } else if (arg == "--alg") {
+            for (auto &a : splitList(value())) opt.algorithms.push_back(a);
+        } else if (arg == "--time") {
+            for (auto &v : splitList(value())) {
+                Time sim = 0;
+                try {
+                    sim = std::stoll(v);
+                } catch (const std::exception&) {
+                    throw std::runtime_error("Invalid simulation time: " + v);
+                }
+                if (sim < 0) {
+                    throw std::runtime_error("Simulation time cannot be negative");
+                }
+                opt.simTimes.push_back(sim);
+            }
+        } else if (arg == "--time-base") {
+            std::string v = value();
+            if (v == "auto") {
+                opt.timeBase.autoDetect = true;
+            } else {
+                try {
+                    opt.timeBase.ticksPerUnit = std::stoll(v);
+                } catch (const std::exception&) {
+                    throw std::runtime_error("Invalid time base: " + v);
+                }
+                if (opt.timeBase.ticksPerUnit <= 0) {
+                    throw std::runtime_error("Time base must be > 0");
+                }
+            }
+        } else if (arg == "--cores") {
+            std::string v = value();
+            try {
+                opt.cores = std::stoi(v);
+            } catch (const std::exception&) {
+                throw std::runtime_error("Invalid number of cores: " + v);
+            }
+            if (opt.cores < 1) {
+                throw std::runtime_error("Number of cores must be >= 1");
+            }
+        } else if (arg == "--partition") {
+            opt.partition = parsePackHeuristic(value());
+        } else if (arg == "--admission") {
+            opt.admission = parseAdmission(value());
+        } else if (arg == "--llf-quantum") {
+            std::string v = value();
+            try {
+                opt.llfQuantum = std::stoll(v);
+            } catch (const std::exception&) {
+                throw std::runtime_error("Invalid LLF quantum: " + v);
+            }
+            if (opt.llfQuantum < 1) {
+                throw std::runtime_error("LLF quantum must be >= 1");
+            }
+        } else if (arg == "--progress") {
+            opt.progress = true;
+        } else if (arg == "--no-timeline") {
+            opt.summary.perTick = false;
+        } else if (arg == "--no-gantt") {
+            opt.summary.gantt = false;
+        } else if (arg == "--output") {
+            opt.output = value();
+        } else if (arg == "--trace") {
+            opt.trace = value();
+        } else if (arg == "--stats") {
+            opt.stats = value();
+            if (!kStatsEnabled) {
+                throw std::runtime_error("--stats needs a build with RT_SCHED_STATS");
+            }
+        } else if (arg == "--analyze") {
+            opt.analyze = true;
+        } else if (arg == "--analyze-only") {
+            opt.analyze = true;
+            opt.simulate = false;
+        } else if (arg == "--sweep") {
+            opt.sweep = true;
+        } else if (arg == "--threads") {
+            std::string v = value();
+            try {
+                opt.threads = static_cast<unsigned>(std::stoul(v));
+            } catch (const std::exception&) {
+                throw std::runtime_error("Invalid thread count: " + v);
+            }
+        } else if (arg == "--engine") {
+            std::string v = value();
+            for (auto &c : v) c = std::tolower(c);
+            if (v == "event") opt.engine = Engine::Event;
+            else if (v == "tick") opt.engine = Engine::Tick;
+            else throw std::runtime_error("Unknown engine: " + v);
+        } else {
+            throw std::runtime_error("Unknown argument: " + arg);
+        }
+    }
+
+    if (opt.inputs.empty() && opt.generated.empty()) {
+        throw std::runtime_error("--input or --generate is required");
+    }
+    if (!opt.saveGenerated.empty() && opt.generated.empty()) {
+        throw std::runtime_error("--save-generated needs --generate");
+    }
+    if (opt.algorithms.empty() && opt.saveGenerated.empty()) {
+        throw std::runtime_error("--alg is required");
+    }
+    if (opt.simTimes.empty()) opt.simTimes.push_back(0);
+    // log-uniform periods rarely have a hyperperiod worth simulating
+    if (!opt.generated.empty() && !opt.algorithms.empty() &&
+        std::find(opt.simTimes.begin(), opt.simTimes.end(), 0) != opt.simTimes.end()) {
+        throw std::runtime_error("--generate needs an explicit --time");
+    }
+    if (opt.partition && !opt.trace.empty()) {
+        throw std::runtime_error("--trace is not supported with --partition");
+    }
+    // trace records carry no processor, so M-core runs would overlap
+    if (opt.cores > 1 && !opt.trace.empty()) {
+        throw std::runtime_error("--trace is not supported with --cores");
+    }
+    if (opt.cores > 1 && !opt.partition && opt.llfQuantum > 1) {
+        throw std::runtime_error("--llf-quantum is not supported with global --cores");
+    }
+    // sweep rows come from one global scheduler per run
+    if (opt.sweep && opt.partition) {
+        throw std::runtime_error("--partition is not supported with --sweep");
+    }
+    // ...and print a CSV row, not a report, so report options have no effect
+    if (opt.sweep) {
+        const char* dropped = !opt.trace.empty() ? "--trace"
+                            : opt.analyze ? "--analyze"
+                            : opt.progress ? "--progress"
+                            : !opt.summary.perTick ? "--no-timeline"
+                            : !opt.summary.gantt ? "--no-gantt"
+                            : nullptr;
+        if (dropped) {
+            throw std::runtime_error(std::string(dropped) + " is not supported with --sweep");
+        }
+    }
+    if (!opt.stats.empty() && (opt.partition || opt.sweep)) {
+        throw std::runtime_error("--stats is not supported with --partition or --sweep");
+    }
+    return opt;
+}
+
+// Hyperperiod used as the default simulation time; warns when the exact
+// value overflows 64 bits or exceeds kHyperperiodCap and the cap is used
+static Time defaultSimTime(const std::vector<PeriodicTask>& tasks) {
+    auto exact = exactHyperperiod(tasks);
+    if (!exact) {
+        std::cerr << "Warning: hyperperiod overflows 64-bit time; using "
+                  << kHyperperiodCap << " ticks instead\n";
+    } else if (*exact > kHyperperiodCap) {
+        std::cerr << "Warning: hyperperiod " << *exact << " exceeds "
+                  << kHyperperiodCap << " ticks; using the cap instead\n";
+    }
+    return hyperperiod(tasks);
+}
+
+// Task set of input i: the files first, then the generated sets
+static TaskSet loadInput(const CliOptions& opt, std::size_t i,
+                         TimeBase& base, std::string& name)
+{
+    TaskSet set;
+    if (i < opt.inputs.size()) {
+        name = opt.inputs[i];
+        std::tie(set.tasks, set.aperiodic, set.serverCfg) = parseInputFile(name, base);
+    } else {
+        const auto &g = opt.generated[i - opt.inputs.size()];
+        name = describe(g);
+        set = generateTaskSet(g);
+        base = TimeBase{};
+    }
+    return set;
+}
+
+// Writes every generated set in the P / A / D input format
+static void saveGenerated(const CliOptions& opt) {
+    for (std::size_t i = 0; i < opt.generated.size(); ++i) {
+        std::string path = opt.generated.size() > 1
+            ? opt.saveGenerated + "." + std::to_string(i + 1)
+            : opt.saveGenerated;
+        std::ofstream out(path);
+        if (!out) throw std::runtime_error("Could not open output file: " + path);
+        TaskSet set = generateTaskSet(opt.generated[i]);
+        out << "# " << describe(opt.generated[i])
+            << " U = " << utilization(set.tasks) << "\n";
+        writeTaskSet(out, set);
+    }
+}
+
+// Set by SIGINT in batch mode; the running scheduler (every core's, with
+// --partition) polls it through its progress hook and stops cooperatively
+static std::atomic<bool> gInterrupted{false};
 
-        auto [tasks, aperiodic, serverCfg] = parseInputFile(path);
+extern "C" void onInterrupt(int) {
+    gInterrupted.store(true);
+}
+
+// Loads each input once and runs every requested algorithm on it
+static int runBatch(const CliOptions& opt) {
+    ServerRuleConfig rules = loadServerRuleConfig("settings.json");
+    std::signal(SIGINT, onInterrupt);
+
+    std::ofstream file;
+    if (!opt.output.empty()) {
+        file.open(opt.output, std::ios::binary);
+        if (!file) throw std::runtime_error("Could not open output file: " + opt.output);
+    }
+    std::ostream& out = opt.output.empty() ? std::cout : file;
+
+    std::ofstream statsFile;
+    if (!opt.stats.empty()) {
+        statsFile.open(opt.stats, std::ios::app);
+        if (!statsFile) throw std::runtime_error("Could not open stats file: " + opt.stats);
+    }
+
+    std::size_t inputs = opt.inputs.size() + opt.generated.size();
+    std::size_t runs = inputs * opt.algorithms.size() * opt.simTimes.size();
+    std::size_t run = 0;
+
+    for (std::size_t i = 0; i < inputs; ++i) {
+        TimeBase base = opt.timeBase;
+        std::string input;
+        TaskSet set = loadInput(opt, i, base, input);
+        const auto &tasks = set.tasks;
+        const auto &aperiodic = set.aperiodic;
+        const auto &serverCfg = set.serverCfg;
 
         if (tasks.empty()) {
             std::cerr << "No periodic tasks found in input file.\n";
             return 1;
         }
 
-        int hp = hyperperiod(tasks);
-        std::cout << "Hyperperiod = " << hp << "\n";
+        Time hp = defaultSimTime(tasks);
+        if (inputs > 1) out << "### " << input << "\n";
+        if (base.ticksPerUnit != 1) {
+            out << "Time base = " << base.ticksPerUnit << " ticks per unit\n";
+        }
+        out << "Hyperperiod = " << hp << "\n";
+        if (i >= opt.inputs.size()) {
+            out << "Utilization = " << utilization(tasks) << "\n";
+        }
 
-        std::string simStr;
-        std::cout << "Simulation time (empty = hyperperiod): ";
-        std::getline(std::cin, simStr);
+        for (const auto &alg : opt.algorithms) {
+            std::string name = alg;
+            for (auto &c : name) c = std::toupper(c);
+            if (opt.analyze) {
+                if (opt.cores > 1) {
+                    out << "\nNo multiprocessor analysis for " << alg << "\n";
+                } else if (name == "RMS" || name == "DMS" || name == "EDF" || name == "LLF") {
+                    out << "\n";
+                    writeAnalysis(out, analyze(name, tasks));
+                } else {
+                    out << "\nNo analysis for " << alg << "\n";
+                }
+            }
+            if (!opt.simulate) continue;
 
+            if (opt.partition) {
+                auto part = partitionTasks(alg, tasks, opt.cores, *opt.partition,
+                                           opt.admission);
+                for (Time sim : opt.simTimes) {
+                    auto scheds = runPartitioned(alg, part, sim > 0 ? sim : hp,
+                                                 opt.engine, opt.threads,
+                                                 opt.llfQuantum,
+                                                 [] { return gInterrupted.load(); });
+                    out << "\n";
+                    writePartitionReport(out, part, scheds, opt.summary);
+                    out << "\n";
+                    for (const auto &s : scheds) {
+                        if (s && s->cancelled()) return 130;
+                    }
+                }
+                continue;
+            }
 
+            for (Time sim : opt.simTimes) {
+                Time simTime = sim > 0 ? sim : hp;
+                auto scheduler = opt.cores > 1
+                    ? buildGlobalScheduler(alg, tasks, simTime, opt.cores)
+                    : buildScheduler(alg, tasks, aperiodic, serverCfg, simTime, rules);
+                scheduler->setEngine(opt.engine);
+                if (name == "LLF") scheduler->setMinQuantum(opt.llfQuantum);
 
-        int simTime = hp;  // default - hyperperiod
-        
-        if (!simStr.empty()) {
-            try {
-                simTime = std::stoi(simStr);
-                if (simTime <= 0) {
-                    std::cerr << "Simulation time must be positive. "
-                                "Falling back to hyperperiod = "
-                            << hp << "\n";
-                    simTime = hp;
+                std::unique_ptr<TraceWriter> trace;
+                ++run;
+                if (!opt.trace.empty()) {
+                    trace = std::make_unique<TraceWriter>(
+                        runs > 1 ? opt.trace + "." + std::to_string(run) : opt.trace);
+                    scheduler->setTrace(trace.get());
                 }
-            } catch (const std::exception&) {
-                std::cerr << "Invalid simulation time input. "
+
+                scheduler->setProgress([&](Time now, Time total) {
+                    if (opt.progress) {
+                        std::cerr << "\r" << alg << ": " << now * 100 / total << "%"
+                                  << std::flush;
+                    }
+                    return !gInterrupted.load();
+                });
+                scheduler->run();
+                if (opt.progress) std::cerr << "\n";
+                if (trace) {
+                    trace->close(scheduler->timeline().labels(), scheduler->simTime());
+                }
+#ifdef RT_SCHED_STATS
+                if (statsFile.is_open()) {
+                    writeStatsJson(statsFile, scheduler->stats(), input, alg, simTime);
+                }
+#endif
+                out << "\n";
+                scheduler->writeSummary(out, opt.summary);
+                out << "\n";
+                if (scheduler->cancelled()) return 130;
+            }
+        }
+    }
+    return 0;
+}
+
+static int runSweepMode(const CliOptions& opt) {
+    SweepConfig cfg;
+    cfg.inputs = opt.inputs;
+    cfg.generated = opt.generated;
+    cfg.algorithms = opt.algorithms;
+    cfg.simTimes = opt.simTimes;
+    cfg.timeBase = opt.timeBase;
+    cfg.engine = opt.engine;
+    cfg.llfQuantum = opt.llfQuantum;
+    cfg.cores = opt.cores;
+    cfg.threads = opt.threads;
+
+    auto results = runSweep(cfg);
+    std::ofstream file;
+    if (!opt.output.empty()) {
+        file.open(opt.output);
+        if (!file) throw std::runtime_error("Could not open output file: " + opt.output);
+    }
+    writeSweepCsv(opt.output.empty() ? std::cout : file, results);
+    for (const auto &r : results) {
+        if (!r.error.empty()) return 1;
+    }
+    return 0;
+}
+
+static int runInteractive() {
+    std::string path;
+    std::cout << "Input file path: ";
+    std::getline(std::cin, path);
+
+    auto [tasks, aperiodic, serverCfg] = parseInputFile(path);
+
+    if (tasks.empty()) {
+        std::cerr << "No periodic tasks found in input file.\n";
+        return 1;
+    }
+
+    Time hp = defaultSimTime(tasks);
+    std::cout << "Hyperperiod = " << hp << "\n";
+
+    std::string simStr;
+    std::cout << "Simulation time (empty = hyperperiod): ";
+    std::getline(std::cin, simStr);
+
+
+
+    Time simTime = hp;  // default - hyperperiod
+    
+    if (!simStr.empty()) {
+        try {
+            simTime = std::stoll(simStr);
+            if (simTime <= 0) {
+                std::cerr << "Simulation time must be positive. "
                             "Falling back to hyperperiod = "
                         << hp << "\n";
                 simTime = hp;
             }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid simulation time input. "
+                        "Falling back to hyperperiod = "
+                    << hp << "\n";
+            simTime = hp;
         }
+    }
 
-        std::cout << "Algorithms:\n"
-                  << "  EDF, RMS, DMS, LLF\n"
-                  << "  BACKGROUND\n"
-                  << "  POLLING, DEFERRABLE, SPORADIC\n";
+    std::cout << "Algorithms:\n"
+              << "  EDF, RMS, DMS, LLF\n"
+              << "  BACKGROUND\n"
+              << "  POLLING, DEFERRABLE, SPORADIC\n";
 
-        std::string alg;
-        std::cout << "Algorithm: ";
-        std::getline(std::cin, alg);
+    std::string alg;
+    std::cout << "Algorithm: ";
+    std::getline(std::cin, alg);
 
-        auto scheduler = buildScheduler(alg, tasks, aperiodic, serverCfg, simTime);
+    auto scheduler = buildScheduler(alg, tasks, aperiodic, serverCfg, simTime);
 
-        scheduler->run();
-        std::cout << "\n" << scheduler->summaryText() << "\n";
+    scheduler->run();
+    std::cout << "\n";
+    scheduler->writeSummary(std::cout);
+    std::cout << "\n";
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    try {
+        if (argc > 1) {
+            for (int i = 1; i < argc; ++i) {
+                std::string arg = argv[i];
+                if (arg == "--help" || arg == "-h") {
+                    printUsage(std::cout);
+                    return 0;
+                }
+            }
+            CliOptions opt = parseArgs(argc, argv);
+            if (!opt.saveGenerated.empty()) {
+                saveGenerated(opt);
+                if (opt.algorithms.empty()) return 0;
+            }
+            return opt.sweep ? runSweepMode(opt) : runBatch(opt);
+        }
+        return runInteractive();
 
     } catch (const std::exception& e) {
         std::cerr << "ERROR: " << e.what() << "\n";
         return 1;
     }
-    return 0;
-}
\ No newline at end of file
+}
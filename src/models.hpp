@@ -3,56 +3,99 @@
 #include <vector>
 #include <numeric>  
 #include <optional>
+#include <cstdint>
+#include <limits>
+
+// Simulation time, in ticks. 64-bit so that nanosecond-resolution task
+// sets and their hyperperiods fit.
+using Time = std::int64_t;
 
 
 struct PeriodicTask {
     std::string name;
-    int arrival;    // r_i
-    int execTime;   // e_i
-    int period;     // p_i
-    int deadline;   // d_i (relative)
+    Time arrival;    // r_i
+    Time execTime;   // e_i
+    Time period;     // p_i
+    Time deadline;   // d_i (relative)
 };
 
+// A job is identified by (taskIndex, releaseIndex): the index of its task
+// in the scheduler's task list and its release number within that task.
 struct PeriodicJob {
     const PeriodicTask* task;
-    int releaseTime;
-    int remaining;
-    int absDeadline;
-    std::string id;
+    int taskIndex;
+    std::int64_t releaseIndex;
+    Time releaseTime;
+    Time remaining;
+    Time absDeadline;
+    long long seq = 0;  // ready-queue arrival order, breaks priority ties
+    int core = -1;      // processor it last ran on (multiprocessor modes)
 
-    PeriodicJob(const PeriodicTask* t, int r)
+    PeriodicJob(const PeriodicTask* t, int taskIdx, std::int64_t releaseIdx, Time r)
         : task(t),
+          taskIndex(taskIdx),
+          releaseIndex(releaseIdx),
           releaseTime(r),
           remaining(t->execTime),
-          absDeadline(r + t->deadline),
-          id(t->name + "@" + std::to_string(r)) {}
+          absDeadline(r + t->deadline) {}
+};
+
+// Finished or missed job as kept in a scheduler's results: the job's
+// identity and the time it completed or was found late. 24 bytes instead
+// of a whole PeriodicJob; release time, deadline and name follow from the
+// task (see PeriodicScheduler::recordName).
+struct JobRecord {
+    Time time;
+    std::int64_t releaseIndex;
+    std::int32_t taskIndex;
 };
 
+inline JobRecord recordOf(const PeriodicJob& job, Time t) {
+    return {t, job.releaseIndex, static_cast<std::int32_t>(job.taskIndex)};
+}
+
 struct AperiodicJob {
     std::string name;
-    int releaseTime;
-    int execTime;
-    int remaining;
+    Time releaseTime;
+    Time execTime;
+    Time remaining;
 };
 
 // Server config: Q, T, D
 // Q = ei, T = pi, D = di 
 struct ServerCfg {
-    int Q;
-    int T;
-    int D;
+    Time Q;
+    Time T;
+    Time D;
 };
 
 // Helper functions
 
-inline int lcm(int a, int b) {
-    return a / std::gcd(a, b) * b;
+// Default simulation length is capped here when the hyperperiod is larger
+// (or does not fit in 64 bits at all)
+constexpr Time kHyperperiodCap = 1'000'000'000'000;   // 10^12 ticks
+
+// lcm(a, b), or nullopt if it does not fit in Time
+inline std::optional<Time> lcm(Time a, Time b) {
+    Time q = a / std::gcd(a, b);
+    if (q != 0 && b > std::numeric_limits<Time>::max() / q) return std::nullopt;
+    return q * b;
 }
 
-inline int hyperperiod(const std::vector<PeriodicTask>& tasks) {
-    int h = 1;
+// Exact hyperperiod, nullopt on 64-bit overflow
+inline std::optional<Time> exactHyperperiod(const std::vector<PeriodicTask>& tasks) {
+    Time h = 1;
     for (const auto& t : tasks) {
-        h = lcm(h, t.period);
+        auto next = lcm(h, t.period);
+        if (!next) return std::nullopt;
+        h = *next;
     }
     return h;
-}
\ No newline at end of file
+}
+
+// Hyperperiod limited to cap; overflow also yields cap
+inline Time hyperperiod(const std::vector<PeriodicTask>& tasks,
+                        Time cap = kHyperperiodCap) {
+    auto h = exactHyperperiod(tasks);
+    return (h && *h <= cap) ? *h : cap;
+}
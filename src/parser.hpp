@@ -4,14 +4,130 @@
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
-#include <cmath>       
+#include <cmath>
+#include <cctype>
+#include <cstdlib>
+#include <algorithm>
+
+// Time base applied while parsing: an input value v becomes
+// v * ticksPerUnit ticks (rounded to the nearest tick).
+// With autoDetect, ticksPerUnit is replaced by the smallest count that
+// turns every value of the file into an exact integer, e.g. 2 for a file
+// whose values are all multiples of 0.5, and 1 for an integer-only file.
+struct TimeBase {
+    Time ticksPerUnit = 1;
+    bool autoDetect = false;
+};
+
+// Decimal literal kept exact: mantissa * 10^exponent
+struct DecimalValue {
+    Time mantissa = 0;
+    int exponent = 0;
+};
+
+inline constexpr int kMaxDecimalDigits = 18;
+inline constexpr int kMaxExponent = 10000;
+
+inline Time powerOf10(int n) {
+    Time p = 1;
+    for (int i = 0; i < n; ++i) p *= 10;
+    return p;
+}
+
+inline Time checkedMul(Time a, Time b) {
+    if (a != 0 && std::llabs(b) > std::numeric_limits<Time>::max() / std::llabs(a)) {
+        throw std::runtime_error("Time value out of range");
+    }
+    return a * b;
+}
+
+// [+-]digits[.digits][(e|E)[+-]digits]
+inline DecimalValue parseDecimal(const std::string& tok) {
+    DecimalValue v;
+    std::size_t i = 0;
+    bool negative = false;
+    if (i < tok.size() && (tok[i] == '+' || tok[i] == '-')) negative = tok[i++] == '-';
+
+    int digits = 0;
+    bool any = false, point = false;
+    for (; i < tok.size(); ++i) {
+        char c = tok[i];
+        if (c == '.' && !point) {
+            point = true;
+        } else if (std::isdigit(static_cast<unsigned char>(c))) {
+            any = true;
+            if (v.mantissa == 0 && c == '0') {
+                if (point) --v.exponent;
+                continue;
+            }
+            if (++digits > kMaxDecimalDigits) {
+                throw std::runtime_error("Too many digits in '" + tok + "'");
+            }
+            v.mantissa = v.mantissa * 10 + (c - '0');
+            if (point) --v.exponent;
+        } else {
+            break;
+        }
+    }
+    if (!any) throw std::runtime_error("Invalid number '" + tok + "'");
+
+    if (i < tok.size() && (tok[i] == 'e' || tok[i] == 'E')) {
+        std::size_t used = 0;
+        int e = 0;
+        try {
+            e = std::stoi(tok.substr(i + 1), &used);
+        } catch (const std::exception&) {
+            throw std::runtime_error("Invalid number '" + tok + "'");
+        }
+        i += 1 + used;
+        // anything past 10^+-kMaxExponent is out of range or rounds to 0
+        // in toTicks anyway; clamping keeps the sum from overflowing
+        long long exponent = static_cast<long long>(v.exponent) + e;
+        v.exponent = static_cast<int>(std::clamp<long long>(
+            exponent, -kMaxExponent, kMaxExponent));
+    }
+    if (i != tok.size()) throw std::runtime_error("Invalid number '" + tok + "'");
+
+    // drop trailing zeros so the exponent reflects the real precision
+    while (v.mantissa != 0 && v.mantissa % 10 == 0) {
+        v.mantissa /= 10;
+        ++v.exponent;
+    }
+    if (v.mantissa == 0) v.exponent = 0;
+    if (negative) v.mantissa = -v.mantissa;
+    return v;
+}
+
+// Decimal places needed to write v exactly
+inline int decimalPlaces(const DecimalValue& v) {
+    return v.exponent < 0 ? -v.exponent : 0;
+}
+
+// v * ticksPerUnit, rounded half away from zero like std::round
+inline Time toTicks(const DecimalValue& v, Time ticksPerUnit) {
+    Time x = checkedMul(v.mantissa, ticksPerUnit);
+    if (v.exponent >= 0) {
+        if (v.exponent > kMaxDecimalDigits) {
+            if (x == 0) return 0;
+            throw std::runtime_error("Time value out of range");
+        }
+        return checkedMul(x, powerOf10(v.exponent));
+    }
+    if (-v.exponent > kMaxDecimalDigits) return 0;
+    Time p = powerOf10(-v.exponent);
+    Time q = x / p, r = x % p;
+    if (2 * std::llabs(r) >= p) q += (x < 0 ? -1 : 1);
+    return q;
+}
 
 // parseInputFile -> (tasks, aperiodicJobs, optional<ServerCfg>)
+// All times are in ticks of base; with base.autoDetect the chosen
+// ticksPerUnit is written back.
 inline std::tuple<
     std::vector<PeriodicTask>,
     std::vector<AperiodicJob>,
     std::optional<ServerCfg>
-> parseInputFile(const std::string& path)
+> parseInputFile(const std::string& path, TimeBase& base)
 {
     std::vector<PeriodicTask> tasks;
     std::vector<AperiodicJob> aperiodic;
@@ -22,9 +138,25 @@ inline std::tuple<
         throw std::runtime_error("Could not open input file: " + path);
     }
 
-    // helper: double -> int (discrete time)
-    auto toInt = [](double x) {
-        return static_cast<int>(std::round(x));
+    if (base.ticksPerUnit <= 0) {
+        throw std::runtime_error("Ticks per time unit must be > 0");
+    }
+
+    // The time base may depend on every value of the file, so lines are
+    // tokenised first and converted to ticks afterwards
+    struct Line {
+        int index;
+        std::string text;
+        std::string tag;
+        std::vector<DecimalValue> nums;
+    };
+    std::vector<Line> lines;
+
+    auto lineError = [](const Line& l, const std::exception& e) {
+        return std::runtime_error(
+            "Error at line " + std::to_string(l.index) +
+            " ('" + l.text + "'): " + e.what()
+        );
     };
 
     std::string raw;
@@ -47,38 +179,61 @@ inline std::tuple<
         }
         if (line.empty()) continue;
 
+        Line l{lineIdx, line, {}, {}};
         std::stringstream ss(line);
-        std::string tag;
-        ss >> tag;
-        for (auto &c : tag) c = std::toupper(c);
+        ss >> l.tag;
+        for (auto &c : l.tag) c = std::toupper(c);
 
         try {
+            std::string tok;
+            while (ss >> tok) l.nums.push_back(parseDecimal(tok));
+        }
+        catch (const std::exception& e) {
+            throw lineError(l, e);
+        }
+        lines.push_back(std::move(l));
+    }
+
+    if (base.autoDetect) {
+        int places = 0;
+        for (const auto &l : lines) {
+            for (const auto &v : l.nums) places = std::max(places, decimalPlaces(v));
+        }
+        // scale by 10^places, then divide out the common factor so the
+        // tick count stays as small as the values allow
+        Time scale = powerOf10(std::min(places, kMaxDecimalDigits));
+        Time g = scale;
+        for (const auto &l : lines) {
+            for (const auto &v : l.nums) {
+                g = std::gcd(g, std::llabs(toTicks(v, scale)));
+            }
+        }
+        base.ticksPerUnit = scale / g;
+    }
+
+    for (const auto &l : lines) {
+        const auto &tag = l.tag;
+        try {
+            std::vector<Time> nums;
+            for (const auto &v : l.nums) nums.push_back(toTicks(v, base.ticksPerUnit));
+
             if (tag == "P") {
                 // P r_i e_i p_i d_i
                 // P r_i e_i p_i
                 // P e_i p_i
-                std::vector<double> nums;
-                double v;
-                while (ss >> v) nums.push_back(v);
-
-                double r_d, e_d, p_d, d_d;
+                Time r_i, e_i, p_i, d_i;
                 if (nums.size() == 4) {
-                    r_d = nums[0]; e_d = nums[1]; p_d = nums[2]; d_d = nums[3];
+                    r_i = nums[0]; e_i = nums[1]; p_i = nums[2]; d_i = nums[3];
                 } else if (nums.size() == 3) {
-                    r_d = nums[0]; e_d = nums[1]; p_d = nums[2]; d_d = p_d;
+                    r_i = nums[0]; e_i = nums[1]; p_i = nums[2]; d_i = p_i;
                 } else if (nums.size() == 2) {
-                    e_d = nums[0]; p_d = nums[1]; r_d = 0.0; d_d = p_d;
+                    e_i = nums[0]; p_i = nums[1]; r_i = 0; d_i = p_i;
                 } else {
                     throw std::runtime_error(
                         "P line must be: 'P ri ei pi di' or 'P ri ei pi' or 'P ei pi'"
                     );
                 }
 
-                int r_i = toInt(r_d);
-                int e_i = toInt(e_d);
-                int p_i = toInt(p_d);
-                int d_i = toInt(d_d);
-
                 // Parameter validation
                 if (p_i <= 0) {
                     throw std::runtime_error("Periodic task period must be > 0");
@@ -99,28 +254,37 @@ inline std::tuple<
             }
             else if (tag == "A") {
                 // A r_i e_i
-                std::vector<double> nums;
-                double v;
-                while (ss >> v) nums.push_back(v);
                 if (nums.size() != 2) {
                     throw std::runtime_error("A line must be: 'A ri ei'");
                 }
-                int r_i = toInt(nums[0]);
-                int e_i = toInt(nums[1]);
+                Time r_i = nums[0];
+                Time e_i = nums[1];
+                if (e_i <= 0) {
+                    throw std::runtime_error("Execution time must be > 0");
+                }
+                if (r_i < 0) {
+                    throw std::runtime_error("Release time cannot be negative");
+                }
                 std::string name = "A" + std::to_string(aperiodic.size() + 1);
                 aperiodic.push_back(AperiodicJob{name, r_i, e_i, e_i});
             }
             else if (tag == "D") {
                 // D e_i p_i d_i  -> server config (Q, T, D)
-                std::vector<double> nums;
-                double v;
-                while (ss >> v) nums.push_back(v);
                 if (nums.size() != 3) {
                     throw std::runtime_error("D line must be: 'D ei pi di'");
                 }
-                int Q = toInt(nums[0]);   // execution budget
-                int T = toInt(nums[1]);   // server period
-                int D = toInt(nums[2]);   // server relative deadline
+                Time Q = nums[0];   // execution budget
+                Time T = nums[1];   // server period
+                Time D = nums[2];   // server relative deadline
+                if (Q <= 0) {
+                    throw std::runtime_error("Server budget must be > 0");
+                }
+                if (T <= 0) {
+                    throw std::runtime_error("Server period must be > 0");
+                }
+                if (D <= 0) {
+                    throw std::runtime_error("Server deadline must be > 0");
+                }
                 serverCfg = ServerCfg{Q, T, D};
             }
             else {
@@ -128,12 +292,20 @@ inline std::tuple<
             }
         }
         catch (const std::exception& e) {
-            throw std::runtime_error(
-                "Error at line " + std::to_string(lineIdx) +
-                " ('" + line + "'): " + e.what()
-            );
+            throw lineError(l, e);
         }
     }
 
     return {tasks, aperiodic, serverCfg};
-}
\ No newline at end of file
+}
+
+// Integer ticks, values rounded to the nearest tick
+inline std::tuple<
+    std::vector<PeriodicTask>,
+    std::vector<AperiodicJob>,
+    std::optional<ServerCfg>
+> parseInputFile(const std::string& path)
+{
+    TimeBase base;
+    return parseInputFile(path, base);
+}
@@ -0,0 +1,205 @@
+#pragma once
+#include "models.hpp"
+#include "analysis.hpp"
+#include "factory.hpp"
+#include "thread_pool.hpp"
+#include <vector>
+#include <string>
+#include <memory>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <cctype>
+#include <functional>
+
+// Partitioned multiprocessor scheduling
+// Tasks are bin-packed onto cores once, in order of decreasing
+// utilization, and each core then runs its own uniprocessor scheduler.
+
+enum class PackHeuristic {
+    FirstFit,   // first core that admits the task
+    BestFit,    // admitting core left with the least spare capacity
+    WorstFit    // admitting core left with the most spare capacity
+};
+
+enum class Admission {
+    Utilization,    // density bound: 1 for EDF/LLF, n(2^(1/n) - 1) for RMS/DMS
+    ResponseTime    // exact test of analysis.hpp (RTA / QPA)
+};
+
+inline PackHeuristic parsePackHeuristic(const std::string& s) {
+    std::string name = s;
+    for (auto &c : name) c = std::toupper(c);
+    if (name == "FF" || name == "FFD") return PackHeuristic::FirstFit;
+    if (name == "BF" || name == "BFD") return PackHeuristic::BestFit;
+    if (name == "WF" || name == "WFD") return PackHeuristic::WorstFit;
+    throw std::runtime_error("Unknown packing heuristic: " + s);
+}
+
+inline Admission parseAdmission(const std::string& s) {
+    std::string name = s;
+    for (auto &c : name) c = std::tolower(c);
+    if (name == "util" || name == "utilization") return Admission::Utilization;
+    if (name == "rta" || name == "exact") return Admission::ResponseTime;
+    throw std::runtime_error("Unknown admission test: " + s);
+}
+
+struct Partition {
+    std::vector<std::vector<PeriodicTask>> cores;   // tasks pinned per core
+    std::vector<PeriodicTask> unassigned;           // admitted nowhere
+};
+
+inline double density(const std::vector<PeriodicTask>& tasks) {
+    double d = 0.0;
+    for (const auto &t : tasks) {
+        d += static_cast<double>(t.execTime) / std::min(t.deadline, t.period);
+    }
+    return d;
+}
+
+// Whether tasks (one core's set) passes the admission test under alg
+inline bool admits(const std::string& alg,
+                   const std::vector<PeriodicTask>& tasks,
+                   Admission test)
+{
+    std::string name = alg;
+    for (auto &c : name) c = std::toupper(c);
+    if (test == Admission::ResponseTime) return analyze(name, tasks).schedulable;
+
+    double bound = 1.0;
+    if (name == "RMS" || name == "DMS") {
+        double n = static_cast<double>(tasks.size());
+        bound = n * (std::pow(2.0, 1.0 / n) - 1.0);
+    }
+    return density(tasks) <= bound + 1e-12;
+}
+
+inline Partition partitionTasks(const std::string& alg,
+                                const std::vector<PeriodicTask>& tasks,
+                                int cores,
+                                PackHeuristic heuristic,
+                                Admission test)
+{
+    if (cores < 1) throw std::runtime_error("Number of cores must be >= 1");
+
+    std::vector<std::size_t> order(tasks.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return static_cast<double>(tasks[a].execTime) / tasks[a].period >
+               static_cast<double>(tasks[b].execTime) / tasks[b].period;
+    });
+
+    Partition p;
+    p.cores.resize(cores);
+    std::vector<double> load(cores, 0.0);
+    std::vector<std::vector<std::size_t>> assigned(cores);
+    for (std::size_t i : order) {
+        const auto &task = tasks[i];
+        double u = static_cast<double>(task.execTime) / task.period;
+        int chosen = -1;
+        for (int c = 0; c < cores; ++c) {
+            auto trial = p.cores[c];
+            trial.push_back(task);
+            if (!admits(alg, trial, test)) continue;
+            if (chosen < 0) {
+                chosen = c;
+                if (heuristic == PackHeuristic::FirstFit) break;
+            } else if (heuristic == PackHeuristic::BestFit ? load[c] > load[chosen]
+                                                           : load[c] < load[chosen]) {
+                chosen = c;
+            }
+        }
+        if (chosen < 0) {
+            p.unassigned.push_back(task);
+            continue;
+        }
+        p.cores[chosen].push_back(task);
+        assigned[chosen].push_back(i);
+        load[chosen] += u;
+    }
+
+    // input order within a core, so RMS/DMS ties break as on one processor
+    for (int c = 0; c < cores; ++c) {
+        std::sort(assigned[c].begin(), assigned[c].end());
+        p.cores[c].clear();
+        for (std::size_t i : assigned[c]) p.cores[c].push_back(tasks[i]);
+    }
+    return p;
+}
+
+// One uniprocessor scheduler per core, run in parallel on a thread pool.
+// Cores without tasks get no scheduler (nullptr). llfQuantum is the
+// minimum quantum of LLF runs (see PeriodicScheduler::setMinQuantum).
+// Every core polls stop (if set) through its progress hook, from the pool
+// threads, and all of them stop once it returns true; cores not started
+// yet stop after their first step.
+inline std::vector<std::unique_ptr<PeriodicScheduler>> runPartitioned(
+    const std::string& alg,
+    const Partition& p,
+    Time simTime,
+    Engine engine,
+    unsigned threads,
+    Time llfQuantum = 1,
+    const std::function<bool()>& stop = {})
+{
+    std::string name = alg;
+    for (auto &c : name) c = std::toupper(c);
+
+    std::vector<std::unique_ptr<PeriodicScheduler>> scheds(p.cores.size());
+    for (std::size_t c = 0; c < p.cores.size(); ++c) {
+        if (p.cores[c].empty()) continue;
+        scheds[c] = buildScheduler(alg, p.cores[c], {}, std::nullopt, simTime,
+                                   ServerRuleConfig{});
+        scheds[c]->setEngine(engine);
+        if (name == "LLF") scheds[c]->setMinQuantum(llfQuantum);
+        if (stop) scheds[c]->setProgress([&stop](Time, Time) { return !stop(); });
+    }
+
+    ThreadPool pool(std::max(1u, std::min<unsigned>(
+        threads, static_cast<unsigned>(p.cores.size()))));
+    for (auto &s : scheds) {
+        if (!s) continue;
+        PeriodicScheduler* sched = s.get();
+        pool.submit([sched, &stop] {
+            if (stop && stop()) sched->cancel();
+            sched->run();
+        });
+    }
+    pool.wait();
+    return scheds;
+}
+
+// Per-core assignment, utilization and misses, then each core's summary
+inline void writePartitionReport(std::ostream& out,
+                                 const Partition& p,
+                                 const std::vector<std::unique_ptr<PeriodicScheduler>>& scheds,
+                                 const SummaryOptions& opt = {})
+{
+    out << "=== Partitioned (" << p.cores.size() << " cores) ===\n";
+    std::size_t finished = 0, missed = 0;
+    for (std::size_t c = 0; c < p.cores.size(); ++c) {
+        out << "Core " << c << ": U = " << utilization(p.cores[c]) << ", tasks";
+        if (p.cores[c].empty()) out << " -";
+        for (const auto &t : p.cores[c]) out << ' ' << t.name;
+        if (scheds[c]) {
+            out << ", finished " << scheds[c]->finished().size()
+                << ", missed " << scheds[c]->missed().size();
+            finished += scheds[c]->finished().size();
+            missed += scheds[c]->missed().size();
+        }
+        out << "\n";
+    }
+    if (!p.unassigned.empty()) {
+        out << "Unassigned:";
+        for (const auto &t : p.unassigned) out << ' ' << t.name;
+        out << "\n";
+    }
+    out << "Total finished " << finished << ", missed " << missed << "\n";
+
+    for (std::size_t c = 0; c < scheds.size(); ++c) {
+        if (!scheds[c]) continue;
+        out << "\n--- Core " << c << " ---\n";
+        scheds[c]->writeSummary(out, opt);
+    }
+}
@@ -1,54 +1,130 @@
 #pragma once
 #include "models.hpp"
+#include "ready_queue.hpp"
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
 
-// Priority Policy Base
-class PriorityPolicy {
-public:
-    virtual ~PriorityPolicy() = default;
-    virtual double key(const PeriodicJob& job, int now) const = 0;
-    virtual std::string name() const = 0;
-};
+// Priority keys
+// Each key type maps a job to an integer key (lower runs first) through
+// static functions, so schedulers templated on it compare jobs inline.
+// The ready queue orders jobs by the key they got at release, so a key must
+// not change while its job waits; time dependent orders are expressed
+// relative to a common origin instead (see LLF).
+//   rekeyOnRun -> the key changes as the job runs (re-keyed after each span)
+//   stableFor  -> ticks the running job keeps its place (see PriorityPolicy)
 
 // RMS
-class RMSPolicy : public PriorityPolicy {
-public:
-    double key(const PeriodicJob& job, int) const override {
+struct RMSKey {
+    static constexpr const char* name = "RMS";
+    static constexpr bool rekeyOnRun = false;
+    static PriorityKey key(const PeriodicJob& job, Time) {
         return job.task->period;
     }
-    std::string name() const override { return "RMS"; }
 };
 
 // DMS
-class DMSPolicy : public PriorityPolicy {
-public:
-    double key(const PeriodicJob& job, int) const override {
+struct DMSKey {
+    static constexpr const char* name = "DMS";
+    static constexpr bool rekeyOnRun = false;
+    static PriorityKey key(const PeriodicJob& job, Time) {
         return job.task->deadline;
     }
-    std::string name() const override { return "DMS"; }
 };
 
 // EDF
-class EDFPolicy : public PriorityPolicy {
-public:
-    double key(const PeriodicJob& job, int) const override {
+struct EDFKey {
+    static constexpr const char* name = "EDF";
+    static constexpr bool rekeyOnRun = false;
+    static PriorityKey key(const PeriodicJob& job, Time) {
         return job.absDeadline;
     }
-    std::string name() const override { return "EDF"; }
 };
 
 // LLF
-class LLFPolicy : public PriorityPolicy {
+// Laxity at time t is (absDeadline - remaining) - t. The t term is the same
+// for every job, so ordering on absDeadline - remaining ranks jobs exactly
+// like their laxities, and that key only changes for the job that runs.
+// The queue therefore stays heap ordered; the scheduler re-keys the
+// running job after each span instead of recomputing every key per tick.
+struct LLFKey {
+    static constexpr const char* name = "LLF";
+    static constexpr bool rekeyOnRun = true;
+
+    static Time laxity(const PeriodicJob& job, Time now) {
+        return job.absDeadline - now - job.remaining;
+    }
+
+    static PriorityKey key(const PeriodicJob& job, Time) {
+        return job.absDeadline - job.remaining;
+    }
+
+    // The running job's key grows by one per tick while the others stay
+    // put, so the runner-up takes over once the running key passes its
+    // own (or reaches it, if the runner-up was queued first).
+    static Time stableFor(const PeriodicJob& running,
+                          const ReadyQueue& ready,
+                          Time /*now*/) {
+        if (ready.top() != &running) return 1;
+        const PeriodicJob* next = ready.runnerUp();
+        if (!next) return std::numeric_limits<Time>::max();
+        Time span = key(*next, 0) - key(running, 0);
+        if (next->seq > running.seq) ++span;
+        return std::max<Time>(span, 1);
+    }
+};
+
+// Priority Policy Base
+class PriorityPolicy {
 public:
-    double key(const PeriodicJob& job, int now) const override {
-        int laxity = job.absDeadline - now - job.remaining;
-        return (laxity < -1'000'000 ? -1'000'000 : laxity);
+    virtual ~PriorityPolicy() = default;
+    // Fixed while the job waits; see the key types above
+    virtual PriorityKey key(const PeriodicJob& job, Time now) const = 0;
+    virtual std::string name() const = 0;
+
+    // Keys that depend on the job's remaining work; the scheduler updates
+    // the running job's key after every span it runs
+    virtual bool rekeyOnRun() const { return false; }
+
+    // How many ticks `running` stays the chosen job among `ready` when
+    // nothing is released, completes or misses meanwhile.
+    // Keys that neither depend on time nor on remaining work never reorder.
+    virtual Time stableFor(const PeriodicJob& /*running*/,
+                           const ReadyQueue& /*ready*/,
+                           Time /*now*/) const {
+        return std::numeric_limits<Time>::max();
     }
-    std::string name() const override { return "LLF"; }
 };
 
+// Runtime policy backed by a key type
+template <class Key>
+class KeyPolicy : public PriorityPolicy {
+public:
+    PriorityKey key(const PeriodicJob& job, Time now) const override {
+        return Key::key(job, now);
+    }
+    std::string name() const override { return Key::name; }
+    bool rekeyOnRun() const override { return Key::rekeyOnRun; }
+
+    Time stableFor(const PeriodicJob& running,
+                   const ReadyQueue& ready,
+                   Time now) const override {
+        if constexpr (!Key::rekeyOnRun) {
+            return PriorityPolicy::stableFor(running, ready, now);
+        } else {
+            return Key::stableFor(running, ready, now);
+        }
+    }
+};
+
+using RMSPolicy = KeyPolicy<RMSKey>;
+using DMSPolicy = KeyPolicy<DMSKey>;
+using EDFPolicy = KeyPolicy<EDFKey>;
+using LLFPolicy = KeyPolicy<LLFKey>;
+
 // Policy factory
 inline std::unique_ptr<PriorityPolicy> makePolicy(const std::string& algName) {
     std::string name = algName;
@@ -60,4 +136,4 @@ inline std::unique_ptr<PriorityPolicy> makePolicy(const std::string& algName) {
     if (name == "LLF") return std::make_unique<LLFPolicy>();
 
     throw std::runtime_error("Unknown policy: " + algName);
-}
\ No newline at end of file
+}
@@ -0,0 +1,259 @@
+#pragma once
+#include "models.hpp"
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+// Priority key; lower runs first
+using PriorityKey = Time;
+
+// Binary min-heap of slot indices that tracks each slot's position, so any
+// slot can be removed in O(log n). Less compares two slots.
+template <class Less>
+class SlotHeap {
+    std::vector<std::size_t> heap_;
+    std::vector<std::size_t> pos_;      // slot -> heap position
+    std::vector<std::size_t> frontier_; // scratch for smallest()
+    Less less_;
+
+    void place(std::size_t i, std::size_t slot) {
+        heap_[i] = slot;
+        pos_[slot] = i;
+    }
+
+    void siftUp(std::size_t i) {
+        std::size_t slot = heap_[i];
+        while (i > 0) {
+            std::size_t parent = (i - 1) / 2;
+            if (!less_(slot, heap_[parent])) break;
+            place(i, heap_[parent]);
+            i = parent;
+        }
+        place(i, slot);
+    }
+
+    void siftDown(std::size_t i) {
+        std::size_t slot = heap_[i];
+        std::size_t n = heap_.size();
+        while (true) {
+            std::size_t child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && less_(heap_[child + 1], heap_[child])) ++child;
+            if (!less_(heap_[child], slot)) break;
+            place(i, heap_[child]);
+            i = child;
+        }
+        place(i, slot);
+    }
+
+public:
+    explicit SlotHeap(Less less) : less_(less) {}
+
+    bool empty() const { return heap_.empty(); }
+    std::size_t size() const { return heap_.size(); }
+    std::size_t top() const { return heap_.front(); }
+
+    // Second smallest slot: the better child of the root (size() >= 2)
+    std::size_t runnerUp() const {
+        if (heap_.size() > 2 && less_(heap_[2], heap_[1])) return heap_[2];
+        return heap_[1];
+    }
+
+    void reserve(std::size_t n) {
+        heap_.reserve(n);
+        pos_.reserve(n);
+    }
+
+    void push(std::size_t slot) {
+        if (slot >= pos_.size()) pos_.resize(slot + 1);
+        heap_.push_back(slot);
+        siftUp(heap_.size() - 1);
+    }
+
+    // Restores the order after slot's key changed
+    void update(std::size_t slot) {
+        siftUp(pos_[slot]);
+        siftDown(pos_[slot]);
+    }
+
+    // The k smallest slots into out, smallest first: a best-first walk
+    // from the root that only visits children of slots already taken,
+    // O(k log k) however large the heap is
+    void smallest(std::size_t k, std::vector<std::size_t>& out) {
+        out.clear();
+        if (heap_.empty() || k == 0) return;
+        // heap positions, ordered as a max-heap so the smallest is in front
+        auto after = [this](std::size_t a, std::size_t b) {
+            return less_(heap_[b], heap_[a]);
+        };
+        frontier_.assign(1, 0);
+        while (out.size() < k && !frontier_.empty()) {
+            std::pop_heap(frontier_.begin(), frontier_.end(), after);
+            std::size_t i = frontier_.back();
+            frontier_.pop_back();
+            out.push_back(heap_[i]);
+            for (std::size_t c = 2 * i + 1; c <= 2 * i + 2 && c < heap_.size(); ++c) {
+                frontier_.push_back(c);
+                std::push_heap(frontier_.begin(), frontier_.end(), after);
+            }
+        }
+    }
+
+    void erase(std::size_t slot) {
+        std::size_t i = pos_[slot];
+        std::size_t last = heap_.back();
+        heap_.pop_back();
+        if (i < heap_.size()) {
+            place(i, last);
+            siftUp(i);
+            siftDown(pos_[last]);
+        }
+    }
+};
+
+// Ready jobs kept in stable slots.
+// The slots are also ordered in a binary min-heap on (priority key, seq), so
+// the highest priority job is found in O(1) and jobs are inserted / removed
+// in O(log n). Ties go to the job that entered the queue first, like the
+// former linear scan did.
+// A second heap orders every job on (absDeadline, seq) so expired jobs are
+// taken from its front without scanning the queue.
+// The slots are the run's job pool: a finished job's slot is reused by the
+// next release, so once the pool has grown to the most jobs ever ready at
+// once, releases allocate nothing. Slot numbers serve as job handles.
+// Pointers to queued jobs stay valid until the next push.
+class ReadyQueue {
+    std::vector<PeriodicJob> jobs_;     // slot -> job
+    std::vector<PriorityKey> key_;      // slot -> priority key
+    std::vector<bool>        live_;
+    std::vector<std::size_t> free_;
+
+    struct ByKey {
+        const ReadyQueue* q;
+        bool operator()(std::size_t a, std::size_t b) const {
+            if (q->key_[a] != q->key_[b]) return q->key_[a] < q->key_[b];
+            return q->jobs_[a].seq < q->jobs_[b].seq;
+        }
+    };
+
+    struct ByDeadline {
+        const ReadyQueue* q;
+        bool operator()(std::size_t a, std::size_t b) const {
+            const auto &ja = q->jobs_[a], &jb = q->jobs_[b];
+            if (ja.absDeadline != jb.absDeadline) return ja.absDeadline < jb.absDeadline;
+            return ja.seq < jb.seq;
+        }
+    };
+
+    SlotHeap<ByKey>      byKey_{ByKey{this}};
+    SlotHeap<ByDeadline> byDeadline_{ByDeadline{this}};
+    std::vector<std::size_t> topSlots_;     // scratch for top(m, out)
+
+    std::size_t size_ = 0;
+    long long nextSeq_ = 0;
+
+    std::size_t slotOf(const PeriodicJob* job) const {
+        return static_cast<std::size_t>(job - jobs_.data());
+    }
+
+public:
+    ReadyQueue() = default;
+
+    // The heaps refer back to this queue
+    ReadyQueue(const ReadyQueue&) = delete;
+    ReadyQueue& operator=(const ReadyQueue&) = delete;
+
+    // Room for n jobs ready at once
+    void reserve(std::size_t n) {
+        jobs_.reserve(n);
+        key_.reserve(n);
+        live_.reserve(n);
+        free_.reserve(n);
+        byKey_.reserve(n);
+        byDeadline_.reserve(n);
+    }
+
+    bool empty() const { return size_ == 0; }
+    std::size_t size() const { return size_; }
+
+    PeriodicJob& push(const PeriodicJob& job, PriorityKey key) {
+        std::size_t slot;
+        if (!free_.empty()) {
+            slot = free_.back();
+            free_.pop_back();
+            jobs_[slot] = job;
+            key_[slot] = key;
+            live_[slot] = true;
+        } else {
+            slot = jobs_.size();
+            jobs_.push_back(job);
+            key_.push_back(key);
+            live_.push_back(true);
+        }
+        jobs_[slot].seq = nextSeq_++;
+        ++size_;
+        byKey_.push(slot);
+        byDeadline_.push(slot);
+        return jobs_[slot];
+    }
+
+    // Highest priority job
+    PeriodicJob* top() {
+        if (byKey_.empty()) return nullptr;
+        return &jobs_[byKey_.top()];
+    }
+
+    const PeriodicJob* top() const {
+        if (byKey_.empty()) return nullptr;
+        return &jobs_[byKey_.top()];
+    }
+
+    // The m highest priority jobs into out, highest first, in
+    // O(m log m); pointers stay valid until the next push
+    void top(std::size_t m, std::vector<PeriodicJob*>& out) {
+        byKey_.smallest(m, topSlots_);
+        out.clear();
+        for (std::size_t s : topSlots_) out.push_back(&jobs_[s]);
+    }
+
+    // Job that would be on top without the current one
+    const PeriodicJob* runnerUp() const {
+        if (byKey_.size() < 2) return nullptr;
+        return &jobs_[byKey_.runnerUp()];
+    }
+
+    // Changes a queued job's key, e.g. after it ran
+    void rekey(const PeriodicJob* job, PriorityKey key) {
+        std::size_t slot = slotOf(job);
+        key_[slot] = key;
+        byKey_.update(slot);
+    }
+
+    // Slots stay with a job while it is queued, even across pushes
+    std::size_t slot(const PeriodicJob* job) const { return slotOf(job); }
+
+    // Job in slot, nullptr if the slot is free
+    PeriodicJob* atSlot(std::size_t slot) {
+        return slot < jobs_.size() && live_[slot] ? &jobs_[slot] : nullptr;
+    }
+
+    // Job with the earliest absolute deadline (first queued on ties)
+    PeriodicJob* earliestDeadline() {
+        if (byDeadline_.empty()) return nullptr;
+        return &jobs_[byDeadline_.top()];
+    }
+
+    const PeriodicJob* earliestDeadline() const {
+        if (byDeadline_.empty()) return nullptr;
+        return &jobs_[byDeadline_.top()];
+    }
+
+    void erase(const PeriodicJob* job) {
+        std::size_t slot = slotOf(job);
+        live_[slot] = false;
+        free_.push_back(slot);
+        --size_;
+        byKey_.erase(slot);
+        byDeadline_.erase(slot);
+    }
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include <ostream>
+#include <string>
+#include <charconv>
+#include <cstddef>
+#include <algorithm>
+
+// What writeSummary prints
+struct SummaryOptions {
+    bool perTick = true;    // "time : task" line per tick
+    bool gantt   = true;    // one Gantt character per tick
+};
+
+// Collects output in a fixed-size buffer and hands it to the stream in
+// chunks, so long reports neither build one huge string nor issue one
+// stream call per token.
+class ChunkedWriter {
+    std::ostream& out_;
+    std::string buf_;
+    std::size_t chunk_;
+
+public:
+    explicit ChunkedWriter(std::ostream& out, std::size_t chunk = 1 << 16)
+        : out_(out), chunk_(chunk)
+    {
+        buf_.reserve(chunk_ + 64);
+    }
+
+    ~ChunkedWriter() { flush(); }
+
+    ChunkedWriter(const ChunkedWriter&) = delete;
+    ChunkedWriter& operator=(const ChunkedWriter&) = delete;
+
+    void flush() {
+        if (!buf_.empty()) {
+            out_.write(buf_.data(), static_cast<std::streamsize>(buf_.size()));
+            buf_.clear();
+        }
+    }
+
+    ChunkedWriter& operator<<(const std::string& s) {
+        buf_ += s;
+        if (buf_.size() >= chunk_) flush();
+        return *this;
+    }
+
+    ChunkedWriter& operator<<(const char* s) {
+        buf_ += s;
+        if (buf_.size() >= chunk_) flush();
+        return *this;
+    }
+
+    ChunkedWriter& operator<<(char c) {
+        buf_ += c;
+        if (buf_.size() >= chunk_) flush();
+        return *this;
+    }
+
+    template <class Int>
+    ChunkedWriter& number(Int v) {
+        char tmp[24];
+        auto res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+        buf_.append(tmp, res.ptr);
+        if (buf_.size() >= chunk_) flush();
+        return *this;
+    }
+
+    // count copies of c, flushed chunk by chunk
+    void repeat(std::size_t count, char c) {
+        while (count > 0) {
+            std::size_t room = buf_.size() < chunk_ ? chunk_ - buf_.size() : 1;
+            std::size_t n = std::min(count, room);
+            buf_.append(n, c);
+            count -= n;
+            if (buf_.size() >= chunk_) flush();
+        }
+    }
+};
@@ -1,186 +1,544 @@
 #pragma once
 #include "models.hpp"
 #include "policies.hpp"
+#include "ready_queue.hpp"
+#include "timeline.hpp"
+#include "report.hpp"
+#include "trace.hpp"
+#include "stats.hpp"
 #include <vector>
 #include <string>
 #include <memory>
 #include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <limits>
+#include <queue>
+#include <functional>
+#include <atomic>
+
+// Simulation engine
+//  Tick  -> one step per time unit
+//  Event -> each step runs until the next release, completion, deadline
+//           or budget event; the resulting schedule is identical
+enum class Engine {
+    Tick,
+    Event
+};
 
 class PeriodicScheduler {
 protected:
     std::vector<PeriodicTask> tasks_;
-    int simTime_;
+    Time simTime_;
     std::unique_ptr<PriorityPolicy> policy_;
+    Engine engine_ = Engine::Event;
+    TraceWriter* trace_ = nullptr;
+
+    // Progress / cancellation (see setProgress, cancel)
+    std::function<bool(Time, Time)> progress_;
+    Time progressEvery_ = 0;
+    std::atomic<bool> cancelRequested_{false};
+    Time stoppedAt_ = -1;       // time run() was cancelled at, -1 = ran to the end
+
+    ReadyQueue ready_;
+    std::vector<JobRecord> finished_;
+    std::vector<JobRecord> missed_;
+    Timeline timeline_;
+    std::vector<int> taskLabels_;   // task index -> timeline label
 
-    std::vector<PeriodicJob> ready_;
-    std::vector<PeriodicJob> finished_;
-    std::vector<PeriodicJob> missed_;
-    std::vector<std::string> timeline_; 
+    // Release calendar: (next release time, task index), earliest first
+    using Release = std::pair<Time, int>;
+    std::priority_queue<Release, std::vector<Release>, std::greater<Release>> releases_;
+
+    // Minimum quantum (1 = off): a dispatched job keeps the processor for
+    // this many ticks, or until it completes or misses, before the policy
+    // may switch jobs. Damps LLF thrashing between jobs of equal laxity.
+    Time minQuantum_ = 1;
+    std::size_t heldSlot_ = 0;
+    std::pair<int, std::int64_t> heldJob_{-1, -1};   // (taskIndex, releaseIndex)
+    Time heldUntil_ = 0;
+
+#ifdef RT_SCHED_STATS
+    SchedStats stats_;
+    std::pair<int, std::int64_t> lastRun_{Timeline::kIdle, -1};   // (label, job) run last
+    bool lastUnfinished_ = false;                                // ... and not done yet
+#endif
 
 public:
     PeriodicScheduler(const std::vector<PeriodicTask>& tasks,
-                      int simTime,
+                      Time simTime,
                       std::unique_ptr<PriorityPolicy> policy)
         : tasks_(tasks),
           simTime_(simTime),
           policy_(std::move(policy)),
-          timeline_(simTime, "IDLE")
-    {}
+          timeline_(simTime)
+    {
+        indexTasks();
+    }
 
-    int simTime() const { return simTime_; }
+    Time simTime() const { return simTime_; }
 
-    const std::vector<std::string>& timeline() const {
+    const std::vector<PeriodicTask>& tasks() const { return tasks_; }
+    const std::vector<JobRecord>& finished() const { return finished_; }
+    const std::vector<JobRecord>& missed() const { return missed_; }
+
+    // Release time, absolute deadline and report name (e.g. "T1@8") of a
+    // recorded job
+    Time releaseTimeOf(const JobRecord& r) const {
+        const auto &task = tasks_[r.taskIndex];
+        return task.arrival + r.releaseIndex * task.period;
+    }
+    Time deadlineOf(const JobRecord& r) const {
+        return releaseTimeOf(r) + tasks_[r.taskIndex].deadline;
+    }
+    std::string recordName(const JobRecord& r) const {
+        return tasks_[r.taskIndex].name + "@" + std::to_string(releaseTimeOf(r));
+    }
+
+    const Timeline& timeline() const {
         return timeline_;
     }
 
+    Engine engine() const { return engine_; }
+    void setEngine(Engine engine) { engine_ = engine; }
+
+    Time minQuantum() const { return minQuantum_; }
+    void setMinQuantum(Time q) { minQuantum_ = std::max<Time>(q, 1); }
+
+    // Records every scheduling event into trace (nullptr = off); the
+    // caller closes the writer with timeline().labels()
+    void setTrace(TraceWriter* trace) { trace_ = trace; }
+
+    // run() calls f(now, simTime) on the running thread each time
+    // simulated time has advanced by `every` ticks (0 = 1% of simTime) and
+    // once at the end; returning false cancels the run
+    void setProgress(std::function<bool(Time, Time)> f, Time every = 0) {
+        progress_ = std::move(f);
+        progressEvery_ = every;
+    }
+
+    // Asks a running run() to stop after its current step; safe to call
+    // from any thread
+    void cancel() { cancelRequested_.store(true, std::memory_order_relaxed); }
+
+    bool cancelled() const { return stoppedAt_ >= 0; }
+    Time stoppedAt() const { return stoppedAt_; }
+
+#ifdef RT_SCHED_STATS
+    const SchedStats& stats() const { return stats_; }
+#endif
+
     virtual ~PeriodicScheduler() = default;
 
-    // integer time steps
-    virtual void releaseJobs(int t) {
-        for (auto &task : tasks_) {
-            if (t < task.arrival) continue;
-            if ((t - task.arrival) % task.period == 0) {
-                ready_.emplace_back(&task, t);
+protected:
+    // Results reserved up front at most this many records (24 bytes each)
+    static constexpr std::size_t kResultReserve = std::size_t(1) << 16;
+
+    // Timeline labels and first releases of tasks_; also sizes the job
+    // pool for one ready job per task and the results for the releases
+    // expected before simTime_, so a run seldom allocates
+    void indexTasks() {
+        taskLabels_.clear();
+        releases_ = {};
+        std::size_t expected = 0;
+        for (int i = 0; i < static_cast<int>(tasks_.size()); ++i) {
+            const auto &task = tasks_[i];
+            taskLabels_.push_back(timeline_.label(task.name));
+            releases_.push({task.arrival, i});
+            if (task.arrival < simTime_ && expected < kResultReserve) {
+                expected += static_cast<std::size_t>(
+                    std::min<Time>((simTime_ - task.arrival) / task.period + 1,
+                                   kResultReserve));
             }
         }
+        ready_.reserve(tasks_.size());
+        finished_.reserve(std::min(expected, kResultReserve));
     }
 
-    virtual void checkDeadlines(int t) {
-        for (auto it = ready_.begin(); it != ready_.end();) {
-            if (t > it->absDeadline && it->remaining > 0) {
-                missed_.push_back(*it);
-                it = ready_.erase(it);
-            } else {
-                ++it;
-            }
-        }
+    int labelOf(const PeriodicJob& job) const {
+        return taskLabels_[job.taskIndex];
     }
 
-    virtual PeriodicJob* chooseJob(int t) {
-        if (ready_.empty()) return nullptr;
-        PeriodicJob *best = &ready_.front();
-        for (auto &j : ready_) {
-            if (policy_->key(j, t) < policy_->key(*best, t)) {
-                best = &j;
-            }
+    void trace(TraceEvent type, Time t, int label, std::int64_t job,
+               Time remaining, Time length = 0) {
+        if (trace_) trace_->write(type, t, label, job, remaining, length);
+    }
+
+    void trace(TraceEvent type, Time t, const PeriodicJob& job, Time length = 0) {
+        if (trace_) {
+            trace_->write(type, t, labelOf(job), job.releaseIndex,
+                          job.remaining, length);
         }
-        return best;
     }
 
-    // Single time step
-    virtual void step(int t) {
+    // Phases of a step, timed in RT_SCHED_STATS builds
+    void timedRelease(Time t) {
+        RT_STATS_TIME(releaseNs);
         releaseJobs(t);
+        RT_STATS(stats_.readyHighWater = std::max(stats_.readyHighWater, ready_.size()));
+    }
+
+    void timedCheckDeadlines(Time t) {
+        RT_STATS_TIME(deadlineNs);
         checkDeadlines(t);
-        auto *job = chooseJob(t);
-        if (!job) {
-            timeline_[t] = "IDLE";
-            return;
+    }
+
+    PeriodicJob* timedChoose(Time t) {
+        RT_STATS_TIME(chooseNs);
+        return chooseJob(t);
+    }
+
+#ifdef RT_SCHED_STATS
+    // Job (label, job) ran and is done or still has work left
+    void noteRun(int label, std::int64_t job, bool done) {
+        std::pair<int, std::int64_t> id{label, job};
+        if (id != lastRun_) {
+            if (lastRun_.second >= 0) ++stats_.contextSwitches;
+            if (lastUnfinished_) ++stats_.preemptions;
+            lastRun_ = id;
+        }
+        lastUnfinished_ = !done;
+        if (done) ++stats_.completions;
+    }
+
+    // A dropped job is not preempted by whatever runs next
+    void noteMiss(const PeriodicJob& job) {
+        ++stats_.deadlineMisses;
+        if (lastRun_ == std::make_pair(labelOf(job), job.releaseIndex)) {
+            lastUnfinished_ = false;
+        }
+    }
+#endif
+
+    // Called with each periodic job as it enters the ready queue
+    virtual void jobReleased(PeriodicJob& /*job*/) {}
+
+public:
+
+    // Releases due at t, in task order; only those tasks are touched
+    virtual void releaseJobs(Time t) {
+        while (!releases_.empty() && releases_.top().first <= t) {
+            auto [r, i] = releases_.top();
+            releases_.pop();
+            const auto &task = tasks_[i];
+            PeriodicJob job(&task, i, (r - task.arrival) / task.period, r);
+            jobReleased(ready_.push(job, policy_->key(job, r)));
+            trace(TraceEvent::Release, r, job);
+            RT_STATS(++stats_.releases);
+            releases_.push({r + task.period, i});
+        }
+    }
+
+    // Expired jobs come off the front of the deadline order; queued jobs
+    // always have work left
+    virtual void checkDeadlines(Time t) {
+        RT_STATS(++stats_.deadlineChecks);
+        while (auto *j = ready_.earliestDeadline()) {
+            if (t <= j->absDeadline) break;
+            trace(TraceEvent::Miss, t, *j);
+            RT_STATS(noteMiss(*j));
+            missed_.push_back(recordOf(*j, t));
+            ready_.erase(j);
+        }
+    }
+
+    // Lowest key, ties going to the job queued first: the heap top
+    virtual PeriodicJob* chooseJob(Time /*t*/) {
+        return ready_.top();
+    }
+
+    // Earliest time after t at which a release or a deadline miss can
+    // change the decision taken at t (simTime_ if there is none)
+    virtual Time nextEventTime(Time /*t*/) const {
+        Time next = simTime_;
+        if (!releases_.empty()) next = std::min(next, releases_.top().first);
+        if (auto *j = ready_.earliestDeadline()) {
+            next = std::min(next, j->absDeadline + 1);
         }
-        job->remaining--;
-        timeline_[t] = job->task->name;
+        return next;
+    }
+
+    // Ticks job stays the chosen one while nothing else happens
+    virtual Time stableFor(const PeriodicJob& job, Time t) const {
+        return policy_->stableFor(job, ready_, t);
+    }
+
+    // The job chosen at t, or the job still holding its minimum quantum
+    PeriodicJob* dispatch(PeriodicJob* chosen, Time t) {
+        if (minQuantum_ <= 1) return chosen;
+        if (t < heldUntil_) {
+            auto *held = ready_.atSlot(heldSlot_);
+            if (held && held->taskIndex == heldJob_.first &&
+                held->releaseIndex == heldJob_.second) {
+                return held;
+            }
+        }
+        if (chosen) {
+            heldSlot_ = ready_.slot(chosen);
+            heldJob_ = {chosen->taskIndex, chosen->releaseIndex};
+            heldUntil_ = t + minQuantum_;
+        }
+        return chosen;
+    }
+
+    // End of the span the decision taken at t is valid for
+    Time horizon(Time t) const {
+        return engine_ == Engine::Tick ? t + 1 : nextEventTime(t);
+    }
+
+    // Runs job from t until end, completion or a policy reordering,
+    // whichever comes first; returns the time it stopped at
+    Time execute(PeriodicJob* job, Time t, Time end) {
+        Time stable = minQuantum_ > 1 ? heldUntil_ - t : stableFor(*job, t);
+        Time len = std::min({end - t, job->remaining, stable});
+        job->remaining -= len;
+        timeline_.append(t, len, labelOf(*job));
+        trace(TraceEvent::Run, t, *job, len);
+        RT_STATS(noteRun(labelOf(*job), job->releaseIndex, job->remaining == 0));
         if (job->remaining == 0) {
-            finished_.push_back(*job);
-            ready_.erase(std::remove_if(ready_.begin(), ready_.end(),
-                [&](const PeriodicJob& j){ return j.id == job->id; }), ready_.end());
+            trace(TraceEvent::Complete, t + len, *job);
+            finished_.push_back(recordOf(*job, t + len));
+            ready_.erase(job);
+        } else if (policy_->rekeyOnRun()) {
+            ready_.rekey(job, policy_->key(*job, t + len));
+        }
+        return t + len;
+    }
+
+    void idle(Time t, Time end) {
+        timeline_.append(t, end - t, Timeline::kIdle);
+    }
+
+    // Single scheduling step starting at t; returns the start of the next one
+    virtual Time step(Time t) {
+        timedRelease(t);
+        timedCheckDeadlines(t);
+        Time end = horizon(t);
+        auto *job = dispatch(timedChoose(t), t);
+        if (!job) {
+            idle(t, end);
+            return end;
         }
+        return execute(job, t, end);
     }
 
+    // Steps until simTime_, or until cancelled; the results then cover
+    // [0, stoppedAt())
     virtual void run() {
-        for (int t = 0; t < simTime_; ++t) {
-            step(t);
+        Time every = progressEvery_ > 0 ? progressEvery_
+                                        : std::max<Time>(simTime_ / 100, 1);
+        Time report = every;
+        for (Time t = 0; t < simTime_;) {
+            t = step(t);
+            RT_STATS(++stats_.steps);
+            bool stop = cancelRequested_.load(std::memory_order_relaxed);
+            if (progress_ && t >= report && t < simTime_) {
+                stop = !progress_(t, simTime_) || stop;
+                report = t + every;
+            }
+            if (stop && t < simTime_) {
+                stoppedAt_ = t;
+                return;
+            }
         }
+        if (progress_) progress_(simTime_, simTime_);
     }
 
-    virtual std::string summaryText() const {
-        std::string out;
-        out += "=== Periodic Scheduler (" + policy_->name() + ") ===\n";
-        out += "Timeline (time: task):\n";
-        for (int t = 0; t < simTime_; ++t) {
-            out += std::to_string(t) + " : " + timeline_[t] + "\n";
+    // Streams the report; buffered in chunks, so memory stays flat
+    // however long the simulation was
+    virtual void writeSummary(std::ostream& os,
+                              const SummaryOptions& opt = {}) const {
+        ChunkedWriter out(os);
+        out << "=== Periodic Scheduler (" << policy_->name() << ") ===\n";
+        if (cancelled()) {
+            out << "Cancelled at ";
+            out.number(stoppedAt_) << '\n';
         }
-        out += "\nFinished jobs: " + std::to_string(finished_.size()) + "\n";
-        out += "Missed deadlines: " + std::to_string(missed_.size()) + "\n";
+        if (opt.perTick) {
+            out << "Timeline (time: task):\n";
+            timeline_.forEachRun([&](const TimelineSegment& s) {
+                const auto &label = timeline_.labelName(s.label);
+                for (Time t = s.start; t < s.start + s.length; ++t) {
+                    out.number(t) << " : " << label << '\n';
+                }
+            });
+        }
+        out << "\nFinished jobs: ";
+        out.number(finished_.size()) << '\n';
+        out << "Missed deadlines: ";
+        out.number(missed_.size()) << '\n';
         if (!missed_.empty()) {
-            out += "Missed jobs:\n";
+            out << "Missed jobs:\n";
             for (const auto &j : missed_) {
-                out += "  " + j.id + " (deadline " +
-                       std::to_string(j.absDeadline) + ")\n";
+                out << "  " << recordName(j) << " (deadline ";
+                out.number(deadlineOf(j)) << ")\n";
             }
         }
-        out += "\nGantt-like:\n";
-        for (int t = 0; t < simTime_; ++t) {
-            const auto &label = timeline_[t];
-            if (label == "IDLE") out += "_";
-            else out += (label.size() > 1 ? label[1] : label[0]);
+        if (opt.gantt) {
+            out << "\nGantt-like:\n";
+            timeline_.forEachRun([&](const TimelineSegment& s) {
+                const auto &label = timeline_.labelName(s.label);
+                char c = s.label == Timeline::kIdle ? '_'
+                       : (label.size() > 1 ? label[1] : label[0]);
+                out.repeat(s.length, c);
+            });
+            out << '\n';
         }
-        out += "\n";
-        return out;
+    }
+
+    std::string summaryText() const {
+        std::ostringstream out;
+        writeSummary(out);
+        return out.str();
     }
 };
 
 
-// Background Scheduler
+// Periodic scheduler specialised on a key type (RMSKey, DMSKey, EDFKey,
+// LLFKey): the stable span of the running job is computed inline instead
+// of going through the virtual PriorityPolicy.
+template <class Key>
+class PeriodicSchedulerT : public PeriodicScheduler {
+public:
+    PeriodicSchedulerT(const std::vector<PeriodicTask>& tasks, Time simTime)
+        : PeriodicScheduler(tasks, simTime, std::make_unique<KeyPolicy<Key>>())
+    {}
+
+    Time stableFor(const PeriodicJob& job, Time t) const override {
+        if constexpr (!Key::rekeyOnRun) {
+            return std::numeric_limits<Time>::max();
+        } else {
+            return Key::stableFor(job, ready_, t);
+        }
+    }
+};
 
-class BackgroundScheduler : public PeriodicScheduler {
-    std::vector<AperiodicJob> aperiodicAll_;
-    std::vector<AperiodicJob> aperiodicReady_;
+
+// Released aperiodic jobs waiting to run, first in first out, as indices
+// into the run's release-sorted job list. Popping only advances the head,
+// so once reserved for every job the queue never allocates.
+class AperiodicFifo {
+    std::vector<std::size_t> items_;
+    std::size_t head_ = 0;
 
 public:
-    BackgroundScheduler(const std::vector<PeriodicTask>& tasks,
-                        const std::vector<AperiodicJob>& aperiodic,
-                        int simTime,
-                        std::unique_ptr<PriorityPolicy> policy)
+    void reserve(std::size_t n) { items_.reserve(n); }
+    bool empty() const { return head_ == items_.size(); }
+    std::size_t size() const { return items_.size() - head_; }
+    std::size_t front() const { return items_[head_]; }
+    void push_back(std::size_t job) { items_.push_back(job); }
+    void pop_front() { ++head_; }
+};
+
+// Aperiodic jobs in release order, ties kept in input order, so they can be
+// released by advancing a cursor
+inline void sortByRelease(std::vector<AperiodicJob>& jobs) {
+    std::stable_sort(jobs.begin(), jobs.end(),
+        [](const AperiodicJob& a, const AperiodicJob& b) {
+            return a.releaseTime < b.releaseTime;
+        });
+}
+
+// Periodic scheduler that also serves aperiodic jobs, first come first
+// served; base of the background and server schedulers, which differ only
+// in when the head of aperiodicReady_ gets to run
+class AperiodicScheduler : public PeriodicScheduler {
+protected:
+    std::vector<AperiodicJob> aperiodicAll_;     // sorted by release time
+    std::size_t nextAperiodic_ = 0;              // first one not yet released
+    AperiodicFifo aperiodicReady_;               // indices into aperiodicAll_
+
+public:
+    AperiodicScheduler(const std::vector<PeriodicTask>& tasks,
+                       const std::vector<AperiodicJob>& aperiodic,
+                       Time simTime,
+                       std::unique_ptr<PriorityPolicy> policy)
         : PeriodicScheduler(tasks, simTime, std::move(policy)),
           aperiodicAll_(aperiodic)
-    {}
+    {
+        sortByRelease(aperiodicAll_);
+        aperiodicReady_.reserve(aperiodicAll_.size());
+    }
 
-    void releaseAperiodic(int t) {
-        for (auto it = aperiodicAll_.begin(); it != aperiodicAll_.end();) {
-            if (it->releaseTime == t) {
-                aperiodicReady_.push_back(*it);
-                it = aperiodicAll_.erase(it);
-            } else {
-                ++it;
+    void releaseAperiodic(Time t) {
+        // jobs released before t were never stepped on and stay unreleased
+        while (nextAperiodic_ < aperiodicAll_.size() &&
+               aperiodicAll_[nextAperiodic_].releaseTime <= t) {
+            std::size_t i = nextAperiodic_++;
+            const auto &aj = aperiodicAll_[i];
+            if (aj.releaseTime < t) continue;
+            // interning the name costs a lookup, so only when tracing
+            if (trace_) {
+                trace(TraceEvent::AperiodicRelease, t, timeline_.label(aj.name),
+                      0, aj.remaining);
             }
+            RT_STATS(++stats_.aperiodicReleases);
+            aperiodicReady_.push_back(i);
         }
     }
 
-    void step(int t) override {
-        // periodic
-        releaseJobs(t);
+    // Periodic and aperiodic releases due at t
+    void releaseJobs(Time t) override {
+        PeriodicScheduler::releaseJobs(t);
         releaseAperiodic(t);
-        checkDeadlines(t);
+    }
 
-        auto *job = chooseJob(t);
-        if (job) {
-            job->remaining--;
-            timeline_[t] = job->task->name;
-            if (job->remaining == 0) {
-                finished_.push_back(*job);
-                ready_.erase(std::remove_if(ready_.begin(), ready_.end(),
-                    [&](const PeriodicJob& j){ return j.id == job->id; }), ready_.end());
+    // Also stops at the next aperiodic arrival
+    Time nextEventTime(Time t) const override {
+        Time next = PeriodicScheduler::nextEventTime(t);
+        for (std::size_t i = nextAperiodic_; i < aperiodicAll_.size(); ++i) {
+            if (aperiodicAll_[i].releaseTime > t) {
+                next = std::min(next, aperiodicAll_[i].releaseTime);
+                break;
             }
-            return;
+        }
+        return next;
+    }
+};
+
+// Background Scheduler
+
+class BackgroundScheduler : public AperiodicScheduler {
+public:
+    BackgroundScheduler(const std::vector<PeriodicTask>& tasks,
+                        const std::vector<AperiodicJob>& aperiodic,
+                        Time simTime,
+                        std::unique_ptr<PriorityPolicy> policy)
+        : AperiodicScheduler(tasks, aperiodic, simTime, std::move(policy))
+    {}
+
+    Time step(Time t) override {
+        timedRelease(t);
+        timedCheckDeadlines(t);
+        Time end = horizon(t);
+
+        auto *job = timedChoose(t);
+        if (job) {
+            return execute(job, t, end);
         }
 
         
         if (!aperiodicReady_.empty()) {
-            auto &aj = aperiodicReady_.front();
-            aj.remaining--;
-            timeline_[t] = aj.name;
+            auto &aj = aperiodicAll_[aperiodicReady_.front()];
+            end = std::min(end, t + aj.remaining);
+            aj.remaining -= end - t;
+            int label = timeline_.label(aj.name);
+            timeline_.append(t, end - t, label);
+            trace(TraceEvent::AperiodicRun, t, label, 0, aj.remaining, end - t);
+            RT_STATS(noteRun(label, 0, aj.remaining == 0));
             if (aj.remaining == 0) {
-                aperiodicReady_.erase(aperiodicReady_.begin());
+                trace(TraceEvent::AperiodicComplete, end, label, 0, 0);
+                aperiodicReady_.pop_front();
             }
         } else {
-            timeline_[t] = "IDLE";
+            idle(t, end);
         }
+        return end;
     }
 
-    std::string summaryText() const override {
-        std::string base = PeriodicScheduler::summaryText();
-        base += "Remaining aperiodic jobs: " +
-                std::to_string(aperiodicReady_.size()) + "\n";
-        return base;
+    void writeSummary(std::ostream& os,
+                      const SummaryOptions& opt = {}) const override {
+        PeriodicScheduler::writeSummary(os, opt);
+        os << "Remaining aperiodic jobs: " << aperiodicReady_.size() << "\n";
     }
-};
\ No newline at end of file
+};
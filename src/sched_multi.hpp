@@ -0,0 +1,219 @@
+#pragma once
+#include "sched_base.hpp"
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+
+// Global multiprocessor scheduler
+// All M processors share one ready queue; at every scheduling point the M
+// highest priority jobs run (global EDF, global RMS/DMS, global LLF).
+// The top M come straight off the ready queue's heap. A job keeps its
+// processor while it stays among them; the others resume on the processor
+// they last ran on when no job keeps it, and only then take any free one.
+// Each processor has its own timeline; the inherited timeline() stays
+// empty.
+class GlobalScheduler : public PeriodicScheduler {
+    using JobId = std::pair<int, std::int64_t>;   // (taskIndex, releaseIndex)
+    static constexpr JobId kNoJob{-1, -1};
+
+    int cores_;
+    std::vector<Timeline> coreTimelines_;
+    std::vector<JobId> running_;    // core -> job it ran during the last step
+    std::vector<std::size_t> runningSlot_;  // ... and that job's ready slot
+    std::vector<PeriodicJob*> top_;         // the current top M
+    std::size_t preemptions_ = 0;
+    std::size_t migrations_ = 0;
+
+    static JobId idOf(const PeriodicJob& job) {
+        return {job.taskIndex, job.releaseIndex};
+    }
+
+    bool wasRunning(const PeriodicJob& job) const {
+        return job.core >= 0 && running_[job.core] == idOf(job);
+    }
+
+    // The M highest priority jobs by core (nullptr = idle core); counts
+    // the preemptions and migrations this decision causes
+    std::vector<PeriodicJob*> assignCores() {
+        ready_.top(cores_, top_);
+
+        // Running jobs keep their core
+        std::vector<PeriodicJob*> onCore(cores_, nullptr);
+        for (auto *j : top_) {
+            if (wasRunning(*j)) onCore[j->core] = j;
+        }
+
+        // A job that ran last step, is still ready and lost its core was
+        // preempted
+        for (int c = 0; c < cores_; ++c) {
+            if (running_[c] == kNoJob || onCore[c]) continue;
+            auto *j = ready_.atSlot(runningSlot_[c]);
+            if (j && idOf(*j) == running_[c]) {
+                ++preemptions_;
+                RT_STATS(++stats_.preemptions);
+            }
+        }
+
+        // Then the others: their last core if it is free, else any free one
+        auto place = [&](PeriodicJob* j, int c) {
+            if (j->core >= 0 && j->core != c) ++migrations_;
+            RT_STATS(if (running_[c] != kNoJob) ++stats_.contextSwitches);
+            onCore[c] = j;
+        };
+        auto placed = [&](const PeriodicJob* j) {
+            return j->core >= 0 && onCore[j->core] == j;
+        };
+        for (auto *j : top_) {
+            if (!placed(j) && j->core >= 0 && !onCore[j->core]) place(j, j->core);
+        }
+        int free = 0;
+        for (auto *j : top_) {
+            if (placed(j)) continue;
+            while (onCore[free]) ++free;
+            place(j, free);
+        }
+        return onCore;
+    }
+
+public:
+    GlobalScheduler(const std::vector<PeriodicTask>& tasks,
+                    Time simTime,
+                    int cores,
+                    std::unique_ptr<PriorityPolicy> policy)
+        : PeriodicScheduler(tasks, simTime, std::move(policy)),
+          cores_(cores),
+          running_(cores, kNoJob),
+          runningSlot_(cores, 0)
+    {
+        if (cores < 1) throw std::runtime_error("Number of cores must be >= 1");
+        // same label ids as timeline_: tasks interned in task order
+        for (int c = 0; c < cores_; ++c) {
+            coreTimelines_.emplace_back(simTime);
+            for (const auto &task : tasks_) coreTimelines_.back().label(task.name);
+        }
+    }
+
+    int cores() const { return cores_; }
+    const Timeline& coreTimeline(int core) const { return coreTimelines_[core]; }
+    std::size_t preemptions() const { return preemptions_; }
+    std::size_t migrations() const { return migrations_; }
+
+    // The minimum quantum and the trace format are single-processor only
+    void run() override {
+        if (minQuantum_ > 1) {
+            throw std::runtime_error("A minimum LLF quantum is not supported on multiple cores");
+        }
+        if (trace_) {
+            throw std::runtime_error("Traces are not supported on multiple cores");
+        }
+        PeriodicScheduler::run();
+    }
+
+    Time step(Time t) override {
+        timedRelease(t);
+        timedCheckDeadlines(t);
+        std::vector<PeriodicJob*> onCore;
+        {
+            RT_STATS_TIME(chooseNs);
+            onCore = assignCores();
+        }
+
+        // Static keys only reorder on releases, completions and misses.
+        // Keys that move as jobs run (LLF) are re-evaluated every tick.
+        bool fixed = !policy_->rekeyOnRun();
+        Time end = fixed ? horizon(t) : t + 1;
+        for (auto *j : onCore) {
+            if (j) end = std::min(end, t + j->remaining);
+        }
+
+        for (int c = 0; c < cores_; ++c) {
+            auto *j = onCore[c];
+            if (!j) {
+                coreTimelines_[c].append(t, end - t, Timeline::kIdle);
+                running_[c] = kNoJob;
+                continue;
+            }
+            j->remaining -= end - t;
+            j->core = c;
+            running_[c] = idOf(*j);
+            runningSlot_[c] = ready_.slot(j);
+            coreTimelines_[c].append(t, end - t, labelOf(*j));
+            trace(TraceEvent::Run, t, *j, end - t);
+        }
+        // completed jobs leave the queue only after every core has run
+        for (auto *j : onCore) {
+            if (j && j->remaining == 0) {
+                trace(TraceEvent::Complete, end, *j);
+                RT_STATS(++stats_.completions);
+                finished_.push_back(recordOf(*j, end));
+                ready_.erase(j);
+            } else if (j && policy_->rekeyOnRun()) {
+                ready_.rekey(j, policy_->key(*j, end));
+            }
+        }
+        return end;
+    }
+
+    void writeSummary(std::ostream& os,
+                      const SummaryOptions& opt = {}) const override {
+        ChunkedWriter out(os);
+        out << "=== Global Scheduler (" << policy_->name() << ", ";
+        out.number(cores_) << " cores) ===\n";
+        if (cancelled()) {
+            out << "Cancelled at ";
+            out.number(stoppedAt_) << '\n';
+        }
+
+        // materialised runs per core, walked side by side
+        std::vector<std::vector<TimelineSegment>> runs(cores_);
+        for (int c = 0; c < cores_; ++c) {
+            coreTimelines_[c].forEachRun([&](const TimelineSegment& s) {
+                runs[c].push_back(s);
+            });
+        }
+
+        if (opt.perTick) {
+            out << "Timeline (time: core 0 | core 1 | ...):\n";
+            std::vector<std::size_t> at(cores_, 0);
+            for (Time t = 0; t < simTime_; ++t) {
+                out.number(t) << " :";
+                for (int c = 0; c < cores_; ++c) {
+                    while (runs[c][at[c]].start + runs[c][at[c]].length <= t) ++at[c];
+                    out << (c ? " | " : " ")
+                        << coreTimelines_[c].labelName(runs[c][at[c]].label);
+                }
+                out << '\n';
+            }
+        }
+        out << "\nFinished jobs: ";
+        out.number(finished_.size()) << '\n';
+        out << "Missed deadlines: ";
+        out.number(missed_.size()) << '\n';
+        if (!missed_.empty()) {
+            out << "Missed jobs:\n";
+            for (const auto &j : missed_) {
+                out << "  " << recordName(j) << " (deadline ";
+                out.number(deadlineOf(j)) << ")\n";
+            }
+        }
+        out << "Preemptions: ";
+        out.number(preemptions_) << '\n';
+        out << "Migrations: ";
+        out.number(migrations_) << '\n';
+        if (opt.gantt) {
+            out << "\nGantt-like:\n";
+            for (int c = 0; c < cores_; ++c) {
+                out << "Core ";
+                out.number(c) << ": ";
+                for (const auto &s : runs[c]) {
+                    const auto &label = coreTimelines_[c].labelName(s.label);
+                    char ch = s.label == Timeline::kIdle ? '_'
+                            : (label.size() > 1 ? label[1] : label[0]);
+                    out.repeat(s.length, ch);
+                }
+                out << '\n';
+            }
+        }
+    }
+};
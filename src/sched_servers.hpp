@@ -3,93 +3,126 @@
 #include "server_rules.hpp"
 #include <utility>
 #include <algorithm>
+#include <deque>
 
-class BaseServerScheduler : public PeriodicScheduler {
+class BaseServerScheduler : public AperiodicScheduler {
 protected:
     PeriodicTask serverTask_;
-    int Q_, T_, D_;   
+    int serverIndex_;   // index of the server task in tasks_
+    Time Q_, T_, D_;
+
+    Time serverBudget_      = 0;
+    Time serverPeriodStart_ = 0;
+
+    // Queued server jobs as (slot, releaseIndex), oldest first, so they
+    // can be dropped without scanning the ready queue. Entries whose job
+    // has since missed are skipped; misses go in release order, so those
+    // are always at the front.
+    std::deque<std::pair<std::size_t, std::int64_t>> serverJobs_;
+
+    PeriodicJob* queuedServerJob(const std::pair<std::size_t, std::int64_t>& e) {
+        auto *job = ready_.atSlot(e.first);
+        return job && job->taskIndex == serverIndex_ && job->releaseIndex == e.second
+            ? job : nullptr;
+    }
 
-    std::vector<AperiodicJob> aperiodicAll_;
-    std::vector<AperiodicJob> aperiodicReady_;
+    void jobReleased(PeriodicJob& job) override {
+        if (job.taskIndex != serverIndex_) return;
+        while (!serverJobs_.empty() && !queuedServerJob(serverJobs_.front())) {
+            serverJobs_.pop_front();
+        }
+        serverJobs_.push_back({ready_.slot(&job), job.releaseIndex});
+    }
 
-    int serverBudget_      = 0;
-    int serverPeriodStart_ = 0;
+    void dropServerJobs() {
+        for (const auto &e : serverJobs_) {
+            if (auto *job = queuedServerJob(e)) ready_.erase(job);
+        }
+        serverJobs_.clear();
+    }
 
 public:
     BaseServerScheduler(const std::vector<PeriodicTask>& tasks,
                         const std::vector<AperiodicJob>& aperiodic,
                         const ServerCfg& cfg,
-                        int simTime,
+                        Time simTime,
                         std::unique_ptr<PriorityPolicy> policy)
-        : PeriodicScheduler({}, simTime, std::move(policy)),
+        : AperiodicScheduler({}, aperiodic, simTime, std::move(policy)),
           serverTask_({"S", 0, cfg.Q, cfg.T, cfg.D}),
-          Q_(cfg.Q), T_(cfg.T), D_(cfg.D),
-          aperiodicAll_(aperiodic)
+          serverIndex_(0),
+          Q_(cfg.Q), T_(cfg.T), D_(cfg.D)
     {
 
         tasks_ = tasks;
         tasks_.push_back(serverTask_);
-        timeline_.assign(simTime_, "IDLE");
+        serverIndex_ = static_cast<int>(tasks_.size()) - 1;
+        indexTasks();
     }
 
-    void releaseAperiodic(int t) {
-        for (auto it = aperiodicAll_.begin(); it != aperiodicAll_.end();) {
-            if (it->releaseTime == t) {
-                aperiodicReady_.push_back(*it);
-                it = aperiodicAll_.erase(it);
-            } else {
-                ++it;
-            }
-        }
+    virtual void updateServerBudget(Time t) = 0;
+
+    // Earliest time after t at which updateServerBudget may change the budget
+    virtual Time nextBudgetEvent(Time t) const {
+        return (t / T_ + 1) * T_;
     }
 
-    virtual void updateServerBudget(int t) = 0;
+    // Most consecutive units the server may serve from t on
+    virtual Time serveLimit(Time /*t*/) const {
+        return serverBudget_;
+    }
+
+    // Server ran `units` ticks from t on (never more than serveLimit(t))
+    virtual void consumeBudget(Time /*t*/, Time units) {
+        serverBudget_ -= std::min(units, serverBudget_);
+    }
 
-    virtual void consumeBudget(int /*t*/) {
-        if (serverBudget_ > 0) --serverBudget_;
+    Time nextEventTime(Time t) const override {
+        return std::min(AperiodicScheduler::nextEventTime(t), nextBudgetEvent(t));
     }
 
-    void step(int t) override {
-        releaseJobs(t);
-        releaseAperiodic(t);
-        checkDeadlines(t);
+    Time step(Time t) override {
+        timedRelease(t);
+        timedCheckDeadlines(t);
+        Time budget = serverBudget_;
         updateServerBudget(t);
+        if (serverBudget_ != budget) {
+            trace(TraceEvent::Budget, t, taskLabels_[serverIndex_], 0, serverBudget_);
+        }
+        Time end = horizon(t);
 
-        auto *job = chooseJob(t);
+        auto *job = timedChoose(t);
 
         // If server job is chosen
-        if (job && job->task == &serverTask_) {
+        if (job && job->taskIndex == serverIndex_) {
             if (serverBudget_ > 0 && !aperiodicReady_.empty()) {
-                auto &aj = aperiodicReady_.front();
-                aj.remaining--;
-                consumeBudget(t);
-                timeline_[t] = aj.name;
+                auto &aj = aperiodicAll_[aperiodicReady_.front()];
+                end = std::min({end, t + aj.remaining, t + serveLimit(t)});
+                consumeBudget(t, end - t);
+                aj.remaining -= end - t;
+                int label = timeline_.label(aj.name);
+                timeline_.append(t, end - t, label);
+                trace(TraceEvent::AperiodicRun, t, label, 0, aj.remaining, end - t);
+                trace(TraceEvent::Budget, end, taskLabels_[serverIndex_], 0, serverBudget_);
+                RT_STATS(noteRun(label, 0, aj.remaining == 0));
                 if (aj.remaining == 0) {
-                    aperiodicReady_.erase(aperiodicReady_.begin());
+                    trace(TraceEvent::AperiodicComplete, end, label, 0, 0);
+                    aperiodicReady_.pop_front();
                 }
-                return;
+                return end;
             } else {
                 // If server cannot serve, remove it from ready and choose again
-                ready_.erase(std::remove_if(ready_.begin(), ready_.end(),
-                    [&](const PeriodicJob& j){ return j.task == &serverTask_; }),
-                    ready_.end());
-                job = chooseJob(t);
+                dropServerJobs();
+                job = timedChoose(t);
             }
         }
 
         // Still no job -> idle
         if (!job) {
-            timeline_[t] = "IDLE";
-            return;
+            idle(t, end);
+            return end;
         }
 
-        job->remaining--;
-        timeline_[t] = job->task->name;
-        if (job->remaining == 0) {
-            finished_.push_back(*job);
-            ready_.erase(std::remove_if(ready_.begin(), ready_.end(),
-                [&](const PeriodicJob& j){ return j.id == job->id; }), ready_.end());
-        }
+        return execute(job, t, end);
     }
 };
 
@@ -101,14 +134,14 @@ public:
     PollingServerScheduler(const std::vector<PeriodicTask>& tasks,
                            const std::vector<AperiodicJob>& aperiodic,
                            const ServerCfg& cfg,
-                           int simTime,
+                           Time simTime,
                            std::unique_ptr<PriorityPolicy> policy,
                            const PollingConfig& pcfg)
         : BaseServerScheduler(tasks, aperiodic, cfg, simTime, std::move(policy)),
           cfg_(pcfg)
     {}
 
-    void updateServerBudget(int t) override {
+    void updateServerBudget(Time t) override {
         if (t % T_ == 0) {
             serverPeriodStart_ = t;
             if (cfg_.budget_if_aperiodic_ready) {
@@ -130,7 +163,7 @@ public:
     DeferrableServerScheduler(const std::vector<PeriodicTask>& tasks,
                               const std::vector<AperiodicJob>& aperiodic,
                               const ServerCfg& cfg,
-                              int simTime,
+                              Time simTime,
                               std::unique_ptr<PriorityPolicy> policy,
                               const DeferrableConfig& dcfg)
         : BaseServerScheduler(tasks, aperiodic, cfg, simTime, std::move(policy)),
@@ -139,7 +172,7 @@ public:
         serverBudget_ = Q_;
     }
 
-    void updateServerBudget(int t) override {
+    void updateServerBudget(Time t) override {
         if (t % T_ == 0) {
             serverPeriodStart_ = t;
             if (cfg_.reset_budget_each_period) {
@@ -153,12 +186,15 @@ public:
 // Sporadic Server
 class SporadicServerScheduler : public BaseServerScheduler {
     SporadicConfig cfg_;
-    std::vector<std::pair<int,int>> replenishments_; // (time, amount)
+    // (time, amount), in time order: consumption only moves forward and the
+    // delay is fixed, so new entries always go to the back
+    std::deque<std::pair<Time,Time>> replenishments_;
+    Time busyEnd_ = -1;     // end of the last consumed span
 public:
     SporadicServerScheduler(const std::vector<PeriodicTask>& tasks,
                             const std::vector<AperiodicJob>& aperiodic,
                             const ServerCfg& cfg,
-                            int simTime,
+                            Time simTime,
                             std::unique_ptr<PriorityPolicy> policy,
                             const SporadicConfig& scfg)
         : BaseServerScheduler(tasks, aperiodic, cfg, simTime, std::move(policy)),
@@ -167,24 +203,50 @@ public:
         serverBudget_ = Q_;
     }
 
-    void updateServerBudget(int t) override {
-        for (auto it = replenishments_.begin(); it != replenishments_.end();) {
-            if (it->first <= t) {
-                serverBudget_ = std::min(Q_, serverBudget_ + it->second);
-                it = replenishments_.erase(it);
-            } else {
-                ++it;
-            }
+    Time nextBudgetEvent(Time t) const override {
+        for (const auto &r : replenishments_) {
+            if (r.first > t) return std::min(simTime_, r.first);
         }
+        return simTime_;
     }
 
-    void consumeBudget(int t) override {
-        if (serverBudget_ <= 0) return;
-        --serverBudget_;
+    // Budget consumed within a span must not be replenished inside it
+    Time serveLimit(Time /*t*/) const override {
+        Time delay = static_cast<Time>(cfg_.replenish_delay_factor * T_);
+        return std::min(serverBudget_, std::max<Time>(delay, 1));
+    }
 
-        int delay = static_cast<int>(cfg_.replenish_delay_factor * T_);
-        int amount = cfg_.replenish_amount;
+    void updateServerBudget(Time t) override {
+        while (!replenishments_.empty() && replenishments_.front().first <= t) {
+            serverBudget_ = std::min<Time>(Q_, serverBudget_ + replenishments_.front().second);
+            replenishments_.pop_front();
+        }
+    }
 
-        replenishments_.push_back({t + delay, amount});
+    // Coalesced: one replenishment per busy interval (a run of consecutive
+    // consumed ticks), due at its start + delay, for everything consumed in
+    // it - as the POSIX sporadic server does. Otherwise one per unit.
+    void consumeBudget(Time t, Time units) override {
+        units = std::min(units, serverBudget_);
+        if (units <= 0) return;
+        serverBudget_ -= units;
+
+        Time delay = static_cast<Time>(cfg_.replenish_delay_factor * T_);
+        Time amount = cfg_.replenish_amount;
+
+        if (cfg_.coalesce_replenishments) {
+            // extend the open interval unless its replenishment already fired
+            if (busyEnd_ == t && !replenishments_.empty() &&
+                replenishments_.back().first > t) {
+                replenishments_.back().second += units * amount;
+            } else {
+                replenishments_.push_back({t + delay, units * amount});
+            }
+            busyEnd_ = t + units;
+        } else {
+            for (Time u = t; u < t + units; ++u) {
+                replenishments_.push_back({u + delay, amount});
+            }
+        }
     }
 };
\ No newline at end of file
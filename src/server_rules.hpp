@@ -15,6 +15,7 @@ struct DeferrableConfig {
 struct SporadicConfig {
     int    replenish_amount       = 1;
     double replenish_delay_factor = 1.0;
+    bool   coalesce_replenishments = true;    // false: one replenishment per unit
 };
 
 struct ServerRuleConfig {
@@ -78,6 +79,10 @@ inline ServerRuleConfig loadServerRuleConfig(const std::string& path)
             cfg.sporadic.replenish_delay_factor =
                 jspr["replenish_delay_factor"].get<double>();
         }
+        if (jspr.contains("coalesce_replenishments")) {
+            cfg.sporadic.coalesce_replenishments =
+                jspr["coalesce_replenishments"].get<bool>();
+        }
     }
 
     return cfg;
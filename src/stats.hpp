@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <nlohmann/json.hpp>
+
+// Hot-path counters and per-phase timing of a scheduler run
+// Collected only when RT_SCHED_STATS is defined (CMake option
+// RT_SCHED_STATS=ON). Otherwise the RT_STATS macros expand to nothing
+// and the schedulers carry no counters or timers at all.
+
+struct SchedStats {
+    std::uint64_t steps = 0;
+    std::uint64_t releases = 0;             // periodic jobs released
+    std::uint64_t aperiodicReleases = 0;
+    std::uint64_t completions = 0;
+    std::uint64_t deadlineChecks = 0;       // checkDeadlines calls
+    std::uint64_t deadlineMisses = 0;
+    std::uint64_t contextSwitches = 0;      // a different job takes the processor
+    std::uint64_t preemptions = 0;          // ... while the previous one has work left
+    std::size_t readyHighWater = 0;         // most jobs ever in the ready queue
+
+    // Time spent in each phase
+    std::uint64_t releaseNs = 0;            // releaseJobs (periodic + aperiodic)
+    std::uint64_t deadlineNs = 0;           // checkDeadlines
+    std::uint64_t chooseNs = 0;             // chooseJob
+};
+
+// Adds the lifetime of the object to total, in nanoseconds
+class StatsTimer {
+    std::uint64_t& total_;
+    std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+
+public:
+    explicit StatsTimer(std::uint64_t& total) : total_(total) {}
+    ~StatsTimer() {
+        total_ += static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start_).count());
+    }
+    StatsTimer(const StatsTimer&) = delete;
+    StatsTimer& operator=(const StatsTimer&) = delete;
+};
+
+#ifdef RT_SCHED_STATS
+#define RT_STATS(stmt) stmt
+#define RT_STATS_TIME(field) StatsTimer statsTimer_(stats_.field)
+#else
+#define RT_STATS(stmt)
+#define RT_STATS_TIME(field)
+#endif
+
+inline constexpr bool kStatsEnabled =
+#ifdef RT_SCHED_STATS
+    true;
+#else
+    false;
+#endif
+
+// One JSON object per line (JSON Lines), so runs can be appended to a
+// file and trended over time
+inline void writeStatsJson(std::ostream& out, const SchedStats& s,
+                           const std::string& input,
+                           const std::string& algorithm,
+                           std::int64_t simTime)
+{
+    nlohmann::json j = {
+        {"input", input},
+        {"algorithm", algorithm},
+        {"sim_time", simTime},
+        {"steps", s.steps},
+        {"releases", s.releases},
+        {"aperiodic_releases", s.aperiodicReleases},
+        {"completions", s.completions},
+        {"deadline_checks", s.deadlineChecks},
+        {"deadline_misses", s.deadlineMisses},
+        {"context_switches", s.contextSwitches},
+        {"preemptions", s.preemptions},
+        {"ready_high_water", s.readyHighWater},
+        {"release_jobs_ns", s.releaseNs},
+        {"check_deadlines_ns", s.deadlineNs},
+        {"choose_job_ns", s.chooseNs}
+    };
+    out << j.dump() << '\n';
+}
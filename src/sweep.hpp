@@ -0,0 +1,147 @@
+#pragma once
+#include "models.hpp"
+#include "parser.hpp"
+#include "factory.hpp"
+#include "generator.hpp"
+#include "thread_pool.hpp"
+#include <string>
+#include <vector>
+#include <ostream>
+
+// Sweep over (input x algorithm x simulation time)
+// Inputs are the files, parsed once each, followed by the generated task
+// sets, built in memory; every combination then runs as an independent
+// task on a work-stealing thread pool.
+
+struct SweepConfig {
+    std::vector<std::string> inputs;
+    std::vector<GeneratorConfig> generated;     // task sets after the files
+    std::vector<std::string> algorithms;
+    std::vector<Time> simTimes;         // 0 = hyperperiod of the input
+    TimeBase timeBase;                  // per file when auto-detected
+    Engine engine = Engine::Event;
+    Time llfQuantum = 1;                // minimum LLF quantum, 1 = off
+    int cores = 1;                      // > 1: global scheduling
+    unsigned threads = std::thread::hardware_concurrency();
+};
+
+struct SweepResult {
+    std::string input;
+    std::string algorithm;
+    Time simTime = 0;
+    Time hyperperiod = 0;
+    Time ticksPerUnit = 1;
+    std::size_t finished = 0;
+    std::size_t missed = 0;
+    std::string error;      // empty on success
+};
+
+// Results come back in (input, algorithm, simTime) order
+inline std::vector<SweepResult> runSweep(const SweepConfig& cfg) {
+    struct Parsed {
+        std::vector<PeriodicTask> tasks;
+        std::vector<AperiodicJob> aperiodic;
+        std::optional<ServerCfg> serverCfg;
+        Time hyperperiod = 0;
+        TimeBase base;
+        std::string error;
+    };
+
+    ServerRuleConfig rules = loadServerRuleConfig("settings.json");
+    ThreadPool pool(cfg.threads);
+
+    std::size_t files = cfg.inputs.size();
+    std::vector<std::string> names = cfg.inputs;
+    for (const auto &g : cfg.generated) names.push_back(describe(g));
+
+    std::vector<Parsed> parsed(names.size());
+    for (std::size_t f = 0; f < names.size(); ++f) {
+        pool.submit([&, f] {
+            auto &p = parsed[f];
+            p.base = cfg.timeBase;
+            try {
+                if (f < files) {
+                    std::tie(p.tasks, p.aperiodic, p.serverCfg) =
+                        parseInputFile(cfg.inputs[f], p.base);
+                } else {
+                    auto set = generateTaskSet(cfg.generated[f - files]);
+                    p.tasks = std::move(set.tasks);
+                    p.aperiodic = std::move(set.aperiodic);
+                    p.serverCfg = set.serverCfg;
+                    p.base = TimeBase{};
+                }
+                if (p.tasks.empty()) {
+                    p.error = "No periodic tasks found in input file.";
+                } else {
+                    p.hyperperiod = hyperperiod(p.tasks);
+                }
+            } catch (const std::exception& e) {
+                p.error = e.what();
+            }
+        });
+    }
+    pool.wait();
+
+    std::vector<SweepResult> results;
+    for (std::size_t f = 0; f < names.size(); ++f) {
+        for (const auto &alg : cfg.algorithms) {
+            for (Time sim : cfg.simTimes) {
+                SweepResult r;
+                r.input = names[f];
+                r.algorithm = alg;
+                r.hyperperiod = parsed[f].hyperperiod;
+                r.ticksPerUnit = parsed[f].base.ticksPerUnit;
+                r.simTime = sim > 0 ? sim : r.hyperperiod;
+                r.error = parsed[f].error;
+                results.push_back(r);
+            }
+        }
+    }
+
+    std::size_t perFile = cfg.algorithms.size() * cfg.simTimes.size();
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        if (!results[i].error.empty()) continue;
+        pool.submit([&, i] {
+            auto &r = results[i];
+            const auto &p = parsed[i / perFile];
+            try {
+                auto scheduler = cfg.cores > 1
+                    ? buildGlobalScheduler(r.algorithm, p.tasks, r.simTime, cfg.cores)
+                    : buildScheduler(r.algorithm, p.tasks, p.aperiodic,
+                                     p.serverCfg, r.simTime, rules);
+                scheduler->setEngine(cfg.engine);
+                std::string name = r.algorithm;
+                for (auto &c : name) c = std::toupper(c);
+                if (name == "LLF") scheduler->setMinQuantum(cfg.llfQuantum);
+                scheduler->run();
+                r.finished = scheduler->finished().size();
+                r.missed = scheduler->missed().size();
+            } catch (const std::exception& e) {
+                r.error = e.what();
+            }
+        });
+    }
+    pool.wait();
+    return results;
+}
+
+// One CSV row per run plus a totals line
+inline void writeSweepCsv(std::ostream& out, const std::vector<SweepResult>& results) {
+    out << "input,algorithm,sim_time,hyperperiod,ticks_per_unit,finished,missed,error\n";
+    std::size_t runs = 0, failed = 0, withMisses = 0;
+    for (const auto &r : results) {
+        out << r.input << ',' << r.algorithm << ',' << r.simTime << ','
+            << r.hyperperiod << ',' << r.ticksPerUnit << ',' << r.finished << ',' << r.missed << ',';
+        if (!r.error.empty()) {
+            out << '"';
+            for (char c : r.error) out << (c == '"' ? '\'' : c);
+            out << '"';
+        }
+        out << '\n';
+        ++runs;
+        if (!r.error.empty()) ++failed;
+        else if (r.missed > 0) ++withMisses;
+    }
+    out << "# runs " << runs << ", failed " << failed
+        << ", with deadline misses " << withMisses << "\n";
+}
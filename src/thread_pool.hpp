@@ -0,0 +1,147 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <exception>
+#include <atomic>
+#include <cstddef>
+
+// Work-stealing thread pool
+// Every worker owns a deque: it takes its own work from the back and,
+// when that runs dry, steals from the front of the others. Tasks
+// submitted from a worker go to that worker's deque, others round-robin.
+// The first exception thrown by a task is rethrown from wait().
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency()) {
+        if (threads == 0) threads = 1;
+        for (unsigned i = 0; i < threads; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        for (unsigned i = 0; i < threads; ++i) {
+            workers_.emplace_back([this, i]{ workerLoop(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto &w : workers_) w.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+    void submit(Task task) {
+        unsigned q = (self().pool == this)
+                         ? self().index
+                         : next_++ % static_cast<unsigned>(queues_.size());
+        {
+            // counted before the task becomes visible: a worker that takes
+            // it at once must not finish it before pending_ covers it
+            std::lock_guard<std::mutex> lk(m_);
+            ++queued_;
+            ++pending_;
+            std::lock_guard<std::mutex> qlk(queues_[q]->m);
+            queues_[q]->tasks.push_back(std::move(task));
+        }
+        wake_.notify_one();
+    }
+
+    // Blocks until every submitted task has finished
+    void wait() {
+        std::unique_lock<std::mutex> lk(m_);
+        done_.wait(lk, [this]{ return pending_ == 0; });
+        if (error_) {
+            auto e = error_;
+            error_ = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+private:
+    struct Queue {
+        std::mutex m;
+        std::deque<Task> tasks;
+    };
+
+    struct WorkerId {
+        const ThreadPool* pool = nullptr;
+        unsigned index = 0;
+    };
+
+    static WorkerId& self() {
+        static thread_local WorkerId id;
+        return id;
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex m_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::size_t queued_ = 0;    // tasks sitting in a deque
+    std::size_t pending_ = 0;   // tasks not finished yet
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::atomic<unsigned> next_{0};
+
+    bool popOwn(unsigned i, Task& out) {
+        auto &q = *queues_[i];
+        std::lock_guard<std::mutex> lk(q.m);
+        if (q.tasks.empty()) return false;
+        out = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(unsigned i, Task& out) {
+        std::size_t n = queues_.size();
+        for (std::size_t k = 1; k < n; ++k) {
+            auto &q = *queues_[(i + k) % n];
+            std::lock_guard<std::mutex> lk(q.m);
+            if (q.tasks.empty()) continue;
+            out = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(unsigned i) {
+        self() = WorkerId{this, i};
+        while (true) {
+            Task task;
+            if (popOwn(i, task) || steal(i, task)) {
+                {
+                    std::lock_guard<std::mutex> lk(m_);
+                    --queued_;
+                }
+                try {
+                    task();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lk(m_);
+                    if (!error_) error_ = std::current_exception();
+                }
+                std::lock_guard<std::mutex> lk(m_);
+                if (--pending_ == 0) done_.notify_all();
+                continue;
+            }
+            std::unique_lock<std::mutex> lk(m_);
+            wake_.wait(lk, [this]{ return stop_ || queued_ > 0; });
+            if (stop_ && queued_ == 0) return;
+        }
+    }
+};
@@ -0,0 +1,116 @@
+#pragma once
+#include "models.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+// One run of consecutive ticks spent on the same label
+struct TimelineSegment {
+    Time start;
+    Time length;
+    int label;      // index into Timeline labels, Timeline::kIdle if idle
+};
+
+// Run-length encoded schedule: (start, length, label) segments instead of
+// one string per tick. Ticks never written read as IDLE.
+class Timeline {
+    Time length_ = 0;
+    std::vector<std::string> labels_;
+    std::unordered_map<std::string, int> labelIds_;
+    std::vector<TimelineSegment> segments_;
+
+    static const std::string& idleName() {
+        static const std::string idle = "IDLE";
+        return idle;
+    }
+
+public:
+    static constexpr int kIdle = -1;
+
+    explicit Timeline(Time length = 0) : length_(length) {}
+
+    Time size() const { return length_; }
+    bool empty() const { return length_ == 0; }
+
+    // Label id for name, added on first use
+    int label(const std::string& name) {
+        if (name == idleName()) return kIdle;
+        auto it = labelIds_.find(name);
+        if (it != labelIds_.end()) return it->second;
+        int id = static_cast<int>(labels_.size());
+        labels_.push_back(name);
+        labelIds_.emplace(name, id);
+        return id;
+    }
+
+    const std::string& labelName(int id) const {
+        return id == kIdle ? idleName() : labels_[id];
+    }
+
+    const std::vector<std::string>& labels() const { return labels_; }
+    const std::vector<TimelineSegment>& segments() const { return segments_; }
+
+    // Ticks [start, start + length) ran label; appended in time order
+    void append(Time start, Time length, int label) {
+        if (length <= 0) return;
+        if (!segments_.empty()) {
+            auto &last = segments_.back();
+            if (last.label == label && last.start + last.length == start) {
+                last.length += length;
+                return;
+            }
+        }
+        segments_.push_back({start, length, label});
+    }
+
+    // Label id running at tick t
+    int labelAt(Time t) const {
+        auto it = std::upper_bound(segments_.begin(), segments_.end(), t,
+            [](Time v, const TimelineSegment& s){ return v < s.start; });
+        if (it == segments_.begin()) return kIdle;
+        --it;
+        return t < it->start + it->length ? it->label : kIdle;
+    }
+
+    const std::string& operator[](Time t) const {
+        return labelName(labelAt(t));
+    }
+
+    // Visits runs covering [0, size()) in order, gaps reported as idle
+    template <class F>
+    void forEachRun(F&& f) const {
+        Time t = 0;
+        for (const auto &s : segments_) {
+            if (s.start > t) f(TimelineSegment{t, s.start - t, kIdle});
+            f(s);
+            t = s.start + s.length;
+        }
+        if (t < length_) f(TimelineSegment{t, length_ - t, kIdle});
+    }
+
+    // Same as forEachRun, restricted to [from, to) and clipped to it.
+    // The first run is found by binary search, so the cost depends on the
+    // runs inside the window, not on the length of the timeline.
+    template <class F>
+    void forEachRunIn(Time from, Time to, F&& f) const {
+        from = std::max<Time>(from, 0);
+        to = std::min(to, length_);
+        if (from >= to) return;
+
+        auto it = std::upper_bound(segments_.begin(), segments_.end(), from,
+            [](Time v, const TimelineSegment& s){ return v < s.start; });
+        if (it != segments_.begin()) --it;
+
+        Time t = from;
+        for (; it != segments_.end() && it->start < to; ++it) {
+            Time start = std::max(it->start, t);
+            Time end = std::min(it->start + it->length, to);
+            if (end <= start) continue;
+            if (start > t) f(TimelineSegment{t, start - t, kIdle});
+            f(TimelineSegment{start, end - start, it->label});
+            t = end;
+        }
+        if (t < to) f(TimelineSegment{t, to - t, kIdle});
+    }
+};
@@ -0,0 +1,257 @@
+#pragma once
+#include "timeline.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define RT_TRACE_MMAP 1
+#endif
+
+// Binary schedule trace
+//
+// Layout (native byte order):
+//   TraceHeader
+//   TraceRecord[recordCount]
+//   label table: uint32 count, then (uint32 length, bytes) per label
+//
+// Records are fixed width, so a reader can map the file and index it
+// directly instead of parsing text.
+
+enum class TraceEvent : std::uint8_t {
+    Release           = 1,  // periodic job released
+    Run               = 2,  // periodic job ran [time, time + length)
+    Complete          = 3,  // periodic job finished at time
+    Miss              = 4,  // periodic job dropped after its deadline
+    AperiodicRelease  = 5,
+    AperiodicRun      = 6,
+    AperiodicComplete = 7,
+    Budget            = 8   // server budget set to `remaining` at time
+};
+
+struct TraceRecord {
+    std::int64_t time;
+    std::int64_t remaining;   // work left after the event (budget for Budget)
+    std::int64_t length;      // ticks covered by Run / AperiodicRun
+    std::int64_t job;         // release index for periodic jobs, else 0
+    std::int32_t label;       // timeline label: task or aperiodic job
+    std::uint8_t type;        // TraceEvent
+    std::uint8_t reserved[3];
+};
+static_assert(sizeof(TraceRecord) == 40, "TraceRecord must stay 40 bytes");
+
+struct TraceHeader {
+    char          magic[8];        // "RTTRACE\0"
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint64_t recordCount;
+    std::uint64_t labelsOffset;    // file offset of the label table
+    std::int64_t  simTime;
+};
+static_assert(sizeof(TraceHeader) == 40, "TraceHeader must stay 40 bytes");
+
+inline constexpr char kTraceMagic[8] = {'R','T','T','R','A','C','E','\0'};
+inline constexpr std::uint32_t kTraceVersion = 2;   // 2: 64-bit job and length
+
+// Buffers records and writes them in blocks. The header is patched and
+// the label table appended by close().
+class TraceWriter {
+    std::ofstream out_;
+    std::vector<TraceRecord> buf_;
+    std::uint64_t count_ = 0;
+    bool closed_ = false;
+
+    void flushRecords() {
+        if (buf_.empty()) return;
+        out_.write(reinterpret_cast<const char*>(buf_.data()),
+                   static_cast<std::streamsize>(buf_.size() * sizeof(TraceRecord)));
+        buf_.clear();
+    }
+
+public:
+    explicit TraceWriter(const std::string& path, std::size_t block = 4096)
+        : out_(path, std::ios::binary | std::ios::trunc)
+    {
+        if (!out_) throw std::runtime_error("Could not open trace file: " + path);
+        TraceHeader h{};
+        std::memcpy(h.magic, kTraceMagic, sizeof(h.magic));
+        h.version = kTraceVersion;
+        h.recordSize = sizeof(TraceRecord);
+        out_.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        buf_.reserve(block);
+    }
+
+    ~TraceWriter() {
+        if (!closed_) {
+            try { close({}, 0); } catch (...) {}
+        }
+    }
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    void write(TraceEvent type, Time time, int label, std::int64_t job,
+               Time remaining, Time length = 0) {
+        TraceRecord r{};
+        r.time = time;
+        r.remaining = remaining;
+        r.label = label;
+        r.job = job;
+        r.length = length;
+        r.type = static_cast<std::uint8_t>(type);
+        buf_.push_back(r);
+        ++count_;
+        if (buf_.size() == buf_.capacity()) flushRecords();
+    }
+
+    std::uint64_t recordCount() const { return count_; }
+
+    // labels[i] names label i of the records
+    void close(const std::vector<std::string>& labels, Time simTime) {
+        if (closed_) return;
+        closed_ = true;
+        flushRecords();
+
+        TraceHeader h{};
+        std::memcpy(h.magic, kTraceMagic, sizeof(h.magic));
+        h.version = kTraceVersion;
+        h.recordSize = sizeof(TraceRecord);
+        h.recordCount = count_;
+        h.labelsOffset = sizeof(TraceHeader) + count_ * sizeof(TraceRecord);
+        h.simTime = simTime;
+
+        std::uint32_t n = static_cast<std::uint32_t>(labels.size());
+        out_.write(reinterpret_cast<const char*>(&n), sizeof(n));
+        for (const auto &l : labels) {
+            std::uint32_t len = static_cast<std::uint32_t>(l.size());
+            out_.write(reinterpret_cast<const char*>(&len), sizeof(len));
+            out_.write(l.data(), len);
+        }
+        out_.seekp(0);
+        out_.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out_.close();
+        if (!out_) throw std::runtime_error("Failed to write trace file");
+    }
+};
+
+// Read-only view of a trace file. The file is memory-mapped where the
+// platform allows it (read into memory otherwise), so opening a
+// multi-GB trace costs no parsing and records are paged in on access.
+class TraceReader {
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::vector<char> fallback_;
+    const TraceHeader* header_ = nullptr;
+    const TraceRecord* records_ = nullptr;
+    std::vector<std::string> labels_;
+
+    void unmap() {
+#ifdef RT_TRACE_MMAP
+        if (data_ && fallback_.empty()) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+#endif
+        data_ = nullptr;
+    }
+
+public:
+    explicit TraceReader(const std::string& path) {
+#ifdef RT_TRACE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Could not open trace file: " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Could not stat trace file: " + path);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ >= sizeof(TraceHeader)) {
+            void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) data_ = static_cast<const char*>(p);
+        }
+        ::close(fd);
+#endif
+        if (!data_) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in) throw std::runtime_error("Could not open trace file: " + path);
+            fallback_.assign(std::istreambuf_iterator<char>(in),
+                             std::istreambuf_iterator<char>());
+            data_ = fallback_.data();
+            size_ = fallback_.size();
+        }
+
+        if (size_ < sizeof(TraceHeader)) {
+            unmap();
+            throw std::runtime_error("Not a trace file: " + path);
+        }
+        header_ = reinterpret_cast<const TraceHeader*>(data_);
+        if (std::memcmp(header_->magic, kTraceMagic, sizeof(kTraceMagic)) != 0 ||
+            header_->version != kTraceVersion ||
+            header_->recordSize != sizeof(TraceRecord) ||
+            // bounded first, so the product below cannot wrap
+            header_->recordCount > (size_ - sizeof(TraceHeader)) / sizeof(TraceRecord) ||
+            header_->labelsOffset > size_ ||
+            header_->labelsOffset != sizeof(TraceHeader) +
+                                     header_->recordCount * sizeof(TraceRecord)) {
+            unmap();
+            throw std::runtime_error("Not a trace file or unsupported version: " + path);
+        }
+        records_ = reinterpret_cast<const TraceRecord*>(data_ + sizeof(TraceHeader));
+
+        // label table
+        std::size_t off = header_->labelsOffset;
+        auto readU32 = [&](std::uint32_t& v) {
+            if (off + sizeof(v) > size_) throw std::runtime_error("Truncated trace file: " + path);
+            std::memcpy(&v, data_ + off, sizeof(v));
+            off += sizeof(v);
+        };
+        try {
+            std::uint32_t n;
+            readU32(n);
+            for (std::uint32_t i = 0; i < n; ++i) {
+                std::uint32_t len;
+                readU32(len);
+                if (off + len > size_) throw std::runtime_error("Truncated trace file: " + path);
+                labels_.emplace_back(data_ + off, len);
+                off += len;
+            }
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    ~TraceReader() { unmap(); }
+
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    std::size_t size() const { return static_cast<std::size_t>(header_->recordCount); }
+    Time simTime() const { return header_->simTime; }
+    const TraceRecord& operator[](std::size_t i) const { return records_[i]; }
+    const TraceRecord* begin() const { return records_; }
+    const TraceRecord* end() const { return records_ + size(); }
+    const std::vector<std::string>& labels() const { return labels_; }
+
+    // Timeline rebuilt from the Run / AperiodicRun records
+    Timeline timeline() const {
+        Timeline tl(simTime());
+        std::vector<int> ids;
+        for (const auto &name : labels_) ids.push_back(tl.label(name));
+        for (const auto &r : *this) {
+            auto type = static_cast<TraceEvent>(r.type);
+            if (type != TraceEvent::Run && type != TraceEvent::AperiodicRun) continue;
+            int id = (r.label >= 0 && r.label < static_cast<int>(ids.size()))
+                         ? ids[r.label] : Timeline::kIdle;
+            tl.append(r.time, r.length, id);
+        }
+        return tl;
+    }
+};
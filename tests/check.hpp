@@ -0,0 +1,52 @@
+#pragma once
+#include <iostream>
+#include <string>
+
+// Minimal checks for the ctest executables. A failed check reports the
+// expression and its location and the test keeps going; main() returns
+// checkResult(), so ctest sees every failure of a run at once.
+
+inline int& checkFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::cerr << __FILE__ << ":" << __LINE__                        \
+                      << ": CHECK failed: " #cond "\n";                     \
+            ++checkFailures();                                              \
+        }                                                                   \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                      \
+    do {                                                                    \
+        auto va_ = (a);                                                     \
+        auto vb_ = (b);                                                     \
+        if (!(va_ == vb_)) {                                                \
+            std::cerr << __FILE__ << ":" << __LINE__                        \
+                      << ": CHECK_EQ failed: " #a " == " #b " ("            \
+                      << va_ << " vs " << vb_ << ")\n";                     \
+            ++checkFailures();                                              \
+        }                                                                   \
+    } while (0)
+
+#define CHECK_THROWS(expr)                                                  \
+    do {                                                                    \
+        bool threw_ = false;                                                \
+        try { (void)(expr); } catch (const std::exception&) { threw_ = true; } \
+        if (!threw_) {                                                      \
+            std::cerr << __FILE__ << ":" << __LINE__                        \
+                      << ": CHECK_THROWS failed: " #expr "\n";              \
+            ++checkFailures();                                              \
+        }                                                                   \
+    } while (0)
+
+inline int checkResult() {
+    if (checkFailures() > 0) {
+        std::cerr << checkFailures() << " check(s) failed\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "generator.hpp"
+
+// Random task set shared by the tests: periods are multiples of 10 up to
+// 120, so a hyperperiod is short enough to simulate in full; deadlines are
+// constrained, and there are aperiodic jobs until 600 and a (3, 12, 12)
+// server for the aperiodic schedulers. Whole-tick execution times on
+// periods this short can land off the requested utilization, so the
+// generator's tolerance check is off.
+inline TaskSet makeTestSet(std::size_t n, double util, std::uint64_t seed) {
+    GeneratorConfig cfg;
+    cfg.tasks = n;
+    cfg.utilization = util;
+    cfg.periodMin = 10;
+    cfg.periodMax = 120;
+    cfg.periodGranularity = 10;
+    cfg.deadlineMin = 0.5;
+    cfg.aperiodicRate = 0.08;
+    cfg.horizon = 600;
+    cfg.server = ServerCfg{3, 12, 12};
+    cfg.tolerance = 0;
+    cfg.seed = seed;
+    return generateTaskSet(cfg);
+}
@@ -0,0 +1,106 @@
+// Schedulability analysis (RTA / QPA) against simulation
+
+#include "check.hpp"
+#include "analysis.hpp"
+#include "factory.hpp"
+#include "fixtures.hpp"
+
+#include <vector>
+
+// Whether a simulated job missed its deadline: dropped, or finished after
+// it (the simulator still runs a job during its deadline tick)
+static bool anyLate(const PeriodicScheduler& s) {
+    if (!s.missed().empty()) return true;
+    for (const auto &r : s.finished()) {
+        if (r.time > s.deadlineOf(r)) return true;
+    }
+    return false;
+}
+
+// Two hyperperiods, so that jobs due at the end of the first are checked
+static bool simulatedLate(const std::string& alg, const std::vector<PeriodicTask>& tasks) {
+    auto s = buildScheduler(alg, tasks, {}, std::nullopt, 2 * hyperperiod(tasks),
+                            ServerRuleConfig{});
+    s->run();
+    return anyLate(*s);
+}
+
+static void exactUtilization() {
+    std::vector<PeriodicTask> thirds = {
+        {"T1", 0, 1, 3, 3}, {"T2", 0, 1, 3, 3}, {"T3", 0, 1, 3, 3}};
+    CHECK_EQ(compareUtilizationToOne(thirds), 0);
+    thirds[2].execTime = 2;
+    CHECK_EQ(compareUtilizationToOne(thirds), 1);
+    thirds.pop_back();
+    CHECK_EQ(compareUtilizationToOne(thirds), -1);
+
+    // exactly 1, but summed in double it comes out as 1.0000000000000002
+    std::vector<PeriodicTask> full = {
+        {"T1", 0, 17, 25, 25}, {"T2", 0, 1, 12, 12},
+        {"T3", 0, 9, 39, 39},  {"T4", 0, 23, 3900, 3900}};
+    CHECK_EQ(compareUtilizationToOne(full), 0);
+    CHECK(analyze("EDF", full).schedulable);
+    CHECK(!simulatedLate("EDF", full));
+
+    // coprime periods whose lcm overflows 64 bits still get an answer
+    std::vector<PeriodicTask> wide;
+    Time primes[] = {1000003, 1000033, 1000037, 1000039};
+    for (Time p : primes) wide.push_back({"T", 0, p / 8, p, p});
+    CHECK_EQ(compareUtilizationToOne(wide), -1);
+}
+
+// Tasks with equal periods released together run in task order, so the
+// later one does not delay the earlier one
+static void equalPriorityTies() {
+    std::vector<PeriodicTask> tasks = {{"T1", 0, 3, 10, 3}, {"T2", 0, 3, 10, 10}};
+    auto res = analyze("RMS", tasks);
+    CHECK(res.schedulable);
+    CHECK_EQ(res.tasks[0].wcrt, 3);
+    CHECK_EQ(res.tasks[1].wcrt, 6);
+    CHECK(!simulatedLate("RMS", tasks));
+
+    // swapped, the tight task comes second and misses
+    std::swap(tasks[0], tasks[1]);
+    CHECK(!analyze("RMS", tasks).schedulable);
+    CHECK(simulatedLate("RMS", tasks));
+
+    // offset releases: the tied task may come first, so both directions count
+    tasks = {{"T1", 0, 3, 10, 3}, {"T2", 5, 3, 10, 10}};
+    CHECK(!analyze("RMS", tasks).schedulable);
+}
+
+// Synchronous sets with many period ties: RTA and QPA must agree with the
+// simulated hyperperiod; DMS ties between different periods are counted
+// both ways, so there only a positive answer has to hold
+static void randomSetsAgreeWithSimulation() {
+    int checked = 0;
+    for (double u : {0.7, 0.85, 0.95, 1.0}) {
+        for (std::size_t n = 2; n <= 6; ++n) {
+            for (std::uint64_t seed = 1; seed <= 12; ++seed) {
+                auto tasks = makeTestSet(n, u, seed).tasks;
+
+                for (const char* alg : {"RMS", "EDF"}) {
+                    bool ok = analyze(alg, tasks).schedulable;
+                    bool late = simulatedLate(alg, tasks);
+                    if (ok == late) {
+                        std::cerr << alg << " n=" << n << " u=" << u
+                                  << " seed=" << seed << ": analysis "
+                                  << (ok ? "schedulable" : "unschedulable")
+                                  << ", simulation " << (late ? "late" : "clean") << "\n";
+                    }
+                    CHECK(ok != late);
+                }
+                if (analyze("DMS", tasks).schedulable) CHECK(!simulatedLate("DMS", tasks));
+                ++checked;
+            }
+        }
+    }
+    CHECK_EQ(checked, 4 * 5 * 12);
+}
+
+int main() {
+    exactUtilization();
+    equalPriorityTies();
+    randomSetsAgreeWithSimulation();
+    return checkResult();
+}
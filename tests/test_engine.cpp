@@ -0,0 +1,136 @@
+// Tick and event engines produce the same schedule
+
+#include "check.hpp"
+#include "factory.hpp"
+#include "fixtures.hpp"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+using Run = std::tuple<Time, Time, std::string>;   // start, length, label
+
+static std::vector<Run> runsOf(const Timeline& tl) {
+    std::vector<Run> out;
+    tl.forEachRun([&](const TimelineSegment& s) {
+        out.emplace_back(s.start, s.length, tl.labelName(s.label));
+    });
+    return out;
+}
+
+static bool sameRecords(const std::vector<JobRecord>& a, const std::vector<JobRecord>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].time != b[i].time || a[i].taskIndex != b[i].taskIndex ||
+            a[i].releaseIndex != b[i].releaseIndex) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void checkSame(const PeriodicScheduler& tick, const PeriodicScheduler& event,
+                      const std::string& what) {
+    bool same = runsOf(tick.timeline()) == runsOf(event.timeline()) &&
+                sameRecords(tick.finished(), event.finished()) &&
+                sameRecords(tick.missed(), event.missed()) &&
+                tick.summaryText() == event.summaryText();
+    if (!same) std::cerr << "engines differ: " << what << "\n";
+    CHECK(same);
+}
+
+// Test set with some arrival offsets
+static TaskSet makeSet(std::size_t n, double u, std::uint64_t seed) {
+    auto set = makeTestSet(n, u, seed);
+    for (std::size_t i = 1; i < set.tasks.size(); i += 3) set.tasks[i].arrival = 2 * i + 1;
+    return set;
+}
+
+static void uniprocessor() {
+    ServerRuleConfig variants[2];
+    variants[1].polling.budget_if_aperiodic_ready = false;
+    variants[1].deferrable.reset_budget_each_period = false;
+    variants[1].sporadic.coalesce_replenishments = false;
+    variants[1].sporadic.replenish_delay_factor = 0.5;
+
+    const char* algs[] = {"EDF", "RMS", "DMS", "LLF", "BACKGROUND",
+                          "POLLING", "DEFERRABLE", "SPORADIC"};
+    for (double u : {0.5, 0.8, 1.2}) {
+        for (std::uint64_t seed = 1; seed <= 6; ++seed) {
+            auto set = makeSet(2 + seed % 5, u, seed);
+            for (const auto &rules : variants) {
+                for (const char* alg : algs) {
+                    std::unique_ptr<PeriodicScheduler> s[2];
+                    for (int e = 0; e < 2; ++e) {
+                        s[e] = buildScheduler(alg, set.tasks, set.aperiodic,
+                                              set.serverCfg, 800, rules);
+                        s[e]->setEngine(e == 0 ? Engine::Tick : Engine::Event);
+                        s[e]->run();
+                    }
+                    checkSame(*s[0], *s[1], std::string(alg) + " seed " +
+                                            std::to_string(seed));
+                }
+            }
+        }
+    }
+}
+
+static void llfQuantum() {
+    for (std::uint64_t seed = 1; seed <= 6; ++seed) {
+        auto set = makeSet(5, 0.9, seed);
+        std::unique_ptr<PeriodicScheduler> s[2];
+        for (int e = 0; e < 2; ++e) {
+            s[e] = buildScheduler("LLF", set.tasks, {}, std::nullopt, 800,
+                                  ServerRuleConfig{});
+            s[e]->setEngine(e == 0 ? Engine::Tick : Engine::Event);
+            s[e]->setMinQuantum(3);
+            s[e]->run();
+        }
+        checkSame(*s[0], *s[1], "LLF quantum seed " + std::to_string(seed));
+    }
+}
+
+static void global() {
+    for (const char* alg : {"EDF", "RMS", "DMS", "LLF"}) {
+        for (std::uint64_t seed = 1; seed <= 4; ++seed) {
+            auto set = makeSet(7, 1.7, seed);
+            std::unique_ptr<PeriodicScheduler> s[2];
+            for (int e = 0; e < 2; ++e) {
+                s[e] = buildGlobalScheduler(alg, set.tasks, 800, 2);
+                s[e]->setEngine(e == 0 ? Engine::Tick : Engine::Event);
+                s[e]->run();
+            }
+            CHECK(sameRecords(s[0]->finished(), s[1]->finished()));
+            CHECK(sameRecords(s[0]->missed(), s[1]->missed()));
+            CHECK(s[0]->summaryText() == s[1]->summaryText());
+        }
+    }
+}
+
+// T1 is preempted at 1 and resumes at 2 together with T4, which never ran:
+// T1 goes back to core 0 and T4 takes core 1, so nothing migrates
+static void globalAffinity() {
+    std::vector<PeriodicTask> tasks = {
+        {"T1", 0, 5, 100, 100},
+        {"T2", 1, 1, 10, 10},
+        {"T3", 1, 1, 10, 10},
+        {"T4", 2, 2, 20, 20},
+    };
+    for (Engine e : {Engine::Tick, Engine::Event}) {
+        GlobalScheduler s(tasks, 10, 2, makePolicy("RMS"));
+        s.setEngine(e);
+        s.run();
+        CHECK_EQ(s.preemptions(), std::size_t(1));
+        CHECK_EQ(s.migrations(), std::size_t(0));
+        CHECK(runsOf(s.coreTimeline(0)) == std::vector<Run>({
+            {0, 1, "T1"}, {1, 1, "T2"}, {2, 4, "T1"}, {6, 4, "IDLE"}}));
+    }
+}
+
+int main() {
+    uniprocessor();
+    llfQuantum();
+    global();
+    globalAffinity();
+    return checkResult();
+}
@@ -0,0 +1,61 @@
+// Task set generator: achieved utilization and spec parsing
+
+#include "check.hpp"
+#include "generator.hpp"
+
+#include <cmath>
+
+// Default periods scale with n, so large sets stay near the request
+static void achievedUtilization() {
+    for (std::size_t n : {1, 10, 100, 5000}) {
+        GeneratorConfig cfg;
+        cfg.tasks = n;
+        cfg.utilization = 0.95;
+        auto set = generateTaskSet(cfg);
+        CHECK_EQ(set.tasks.size(), n);
+        CHECK(std::abs(utilization(set.tasks) - 0.95) <= 0.05 * 0.95);
+        for (const auto &t : set.tasks) {
+            CHECK(t.execTime >= 1 && t.execTime <= t.period);
+            CHECK(t.deadline >= t.execTime && t.deadline <= t.period);
+        }
+    }
+
+    // every share rounds up to a whole tick: far above the request
+    GeneratorConfig cfg;
+    cfg.tasks = 5000;
+    cfg.utilization = 0.95;
+    cfg.periodMin = 10;
+    cfg.periodMax = 1000;
+    CHECK_THROWS(generateTaskSet(cfg));
+    cfg.tolerance = 0;
+    CHECK(utilization(generateTaskSet(cfg).tasks) > 10.0);
+}
+
+static void sameSeedSameSet() {
+    auto cfgs = parseGeneratorSpec("n=12,u=0.7,seed=5,count=2,aperiodic=0.05,server=2:10");
+    CHECK_EQ(cfgs.size(), std::size_t(2));
+    CHECK_EQ(cfgs[1].seed, std::uint64_t(6));
+    auto a = generateTaskSet(cfgs[0]), b = generateTaskSet(cfgs[0]);
+    CHECK_EQ(a.tasks.size(), b.tasks.size());
+    for (std::size_t i = 0; i < a.tasks.size(); ++i) {
+        CHECK_EQ(a.tasks[i].execTime, b.tasks[i].execTime);
+        CHECK_EQ(a.tasks[i].period, b.tasks[i].period);
+    }
+    CHECK_EQ(a.aperiodic.size(), b.aperiodic.size());
+    CHECK(a.serverCfg.has_value());
+}
+
+static void specErrors() {
+    CHECK_THROWS(parseGeneratorSpec("n=0"));
+    CHECK_THROWS(parseGeneratorSpec("periods=0:10"));
+    CHECK_THROWS(parseGeneratorSpec("periods=100:10"));
+    CHECK_THROWS(parseGeneratorSpec("bogus=1"));
+    CHECK_EQ(parseGeneratorSpec("tolerance=0.2")[0].tolerance, 0.2);
+}
+
+int main() {
+    achievedUtilization();
+    sameSeedSameSet();
+    specErrors();
+    return checkResult();
+}
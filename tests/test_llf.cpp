@@ -0,0 +1,131 @@
+// Incremental LLF against the original per-tick implementation
+
+#include "check.hpp"
+#include "factory.hpp"
+#include "fixtures.hpp"
+
+#include <vector>
+#include <string>
+
+// The scheduler LLF started from: every tick, release, drop expired jobs,
+// then run the job with the least laxity clamped at -10^6, ties going to
+// the job queued first
+struct BaselineLLF {
+    static constexpr Time kMinLaxity = -1'000'000;
+
+    struct Job {
+        int task;
+        Time remaining;
+        Time absDeadline;
+    };
+
+    std::vector<int> timeline;      // task index per tick, -1 = idle
+    std::size_t finished = 0;
+    std::size_t missed = 0;
+
+    BaselineLLF(const std::vector<PeriodicTask>& tasks, Time simTime) {
+        std::vector<Job> ready;
+        for (Time t = 0; t < simTime; ++t) {
+            for (int i = 0; i < static_cast<int>(tasks.size()); ++i) {
+                const auto &task = tasks[i];
+                if (t >= task.arrival && (t - task.arrival) % task.period == 0) {
+                    ready.push_back({i, task.execTime, t + task.deadline});
+                }
+            }
+            for (auto it = ready.begin(); it != ready.end();) {
+                if (t > it->absDeadline) {
+                    ++missed;
+                    it = ready.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            auto key = [&](const Job& j) {
+                return std::max(j.absDeadline - t - j.remaining, kMinLaxity);
+            };
+            Job *best = nullptr;
+            for (auto &j : ready) {
+                if (!best || key(j) < key(*best)) best = &j;
+            }
+            if (!best) {
+                timeline.push_back(-1);
+                continue;
+            }
+            timeline.push_back(best->task);
+            if (--best->remaining == 0) {
+                ++finished;
+                ready.erase(ready.begin() + (best - ready.data()));
+            }
+        }
+    }
+};
+
+static std::unique_ptr<PeriodicScheduler> runLLF(const std::vector<PeriodicTask>& tasks,
+                                                 Time simTime, Engine engine) {
+    auto s = buildScheduler("LLF", tasks, {}, std::nullopt, simTime, ServerRuleConfig{});
+    s->setEngine(engine);
+    s->run();
+    return s;
+}
+
+// Task index running at every tick of s
+static std::vector<int> ticksOf(const PeriodicScheduler& s) {
+    std::vector<int> out;
+    s.timeline().forEachRun([&](const TimelineSegment& seg) {
+        for (Time t = 0; t < seg.length; ++t) out.push_back(seg.label);
+    });
+    return out;
+}
+
+// Laxities stay far above the clamp: same schedule tick for tick
+static void matchesBaseline() {
+    int compared = 0;
+    for (double u : {0.6, 0.9, 1.1, 1.4}) {
+        for (std::uint64_t seed = 1; seed <= 10; ++seed) {
+            auto tasks = makeTestSet(2 + seed % 5, u, seed).tasks;
+            for (std::size_t i = 0; i < tasks.size(); i += 2) tasks[i].arrival = i;
+            Time sim = std::min<Time>(hyperperiod(tasks), 5000);
+
+            BaselineLLF ref(tasks, sim);
+            for (Engine e : {Engine::Event, Engine::Tick}) {
+                auto s = runLLF(tasks, sim, e);
+                CHECK(ticksOf(*s) == ref.timeline);
+                CHECK_EQ(s->finished().size(), ref.finished);
+                CHECK_EQ(s->missed().size(), ref.missed);
+            }
+            ++compared;
+        }
+    }
+    CHECK_EQ(compared, 40);
+}
+
+// Below -10^6 the baseline clamped every laxity to the same key and kept
+// running the job queued first; the unclamped key still runs the job with
+// the least laxity. Both jobs start beyond the clamp here: T2 has the
+// lower laxity, so it now runs first, until T1's laxity (falling while it
+// waits) reaches T2's after 300000 ticks and the tie goes to T1.
+static void negativeLaxityOrder() {
+    std::vector<PeriodicTask> tasks = {
+        {"T1", 0, 1'500'000, 400'000, 400'000},    // laxity -1.1 * 10^6
+        {"T2", 0, 1'800'000, 400'000, 400'000}};   // laxity -1.4 * 10^6
+    Time sim = 400'002;
+
+    BaselineLLF ref(tasks, sim);
+    CHECK_EQ(ref.timeline[0], 0);
+    CHECK_EQ(ref.timeline[399'999], 0);
+
+    for (Engine e : {Engine::Event, Engine::Tick}) {
+        auto s = runLLF(tasks, sim, e);
+        auto ticks = ticksOf(*s);
+        CHECK_EQ(ticks[0], 1);
+        CHECK_EQ(ticks[299'999], 1);
+        CHECK_EQ(ticks[300'000], 0);
+        CHECK_EQ(s->missed().size(), ref.missed);
+    }
+}
+
+int main() {
+    matchesBaseline();
+    negativeLaxityOrder();
+    return checkResult();
+}
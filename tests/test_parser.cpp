@@ -0,0 +1,134 @@
+// Decimal parsing and time bases
+
+#include "check.hpp"
+#include "parser.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+static std::string writeInput(const std::string& name, const std::string& text) {
+    auto path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream out(path);
+    out << text;
+    return path;
+}
+
+static void decimals() {
+    auto v = parseDecimal("00012.3400");
+    CHECK_EQ(v.mantissa, Time(1234));
+    CHECK_EQ(v.exponent, -2);
+    CHECK_EQ(decimalPlaces(v), 2);
+
+    v = parseDecimal("1.5e-2");
+    CHECK_EQ(v.mantissa, Time(15));
+    CHECK_EQ(v.exponent, -3);
+    v = parseDecimal("2500");
+    CHECK_EQ(v.mantissa, Time(25));
+    CHECK_EQ(v.exponent, 2);
+    CHECK_EQ(decimalPlaces(v), 0);
+    v = parseDecimal("0.000");
+    CHECK_EQ(v.mantissa, Time(0));
+    CHECK_EQ(v.exponent, 0);
+    CHECK_EQ(parseDecimal("-2.5").mantissa, Time(-25));
+    CHECK_EQ(parseDecimal("+3").mantissa, Time(3));
+    CHECK_EQ(parseDecimal(".5").exponent, -1);
+    CHECK_EQ(parseDecimal("5.").exponent, 0);
+    CHECK_EQ(parseDecimal("1E3").exponent, 3);
+
+    // leading zeros do not count towards the 18 significant digits
+    CHECK_EQ(parseDecimal("0000000000000000000000000001").mantissa, Time(1));
+    CHECK_EQ(parseDecimal("123456789012345678").mantissa, Time(123456789012345678));
+    CHECK_THROWS(parseDecimal("1234567890123456789"));
+
+    for (const char* bad : {"", ".", "-", "e5", "1.2.3", "1e", "1e+", "12a", "1e99999999999"}) {
+        CHECK_THROWS(parseDecimal(bad));
+    }
+
+    // extreme exponents saturate instead of overflowing
+    CHECK_EQ(toTicks(parseDecimal("0.1e-2147483648"), 1000), Time(0));
+    CHECK_THROWS(toTicks(parseDecimal("1e2147483647"), 1));
+}
+
+static void ticks() {
+    CHECK_EQ(toTicks(parseDecimal("1.5"), 1), Time(2));      // half away from zero
+    CHECK_EQ(toTicks(parseDecimal("2.5"), 1), Time(3));
+    CHECK_EQ(toTicks(parseDecimal("-2.5"), 1), Time(-3));
+    CHECK_EQ(toTicks(parseDecimal("0.49"), 1), Time(0));
+    CHECK_EQ(toTicks(parseDecimal("0.25"), 4), Time(1));
+    CHECK_EQ(toTicks(parseDecimal("1.5e-2"), 1000), Time(15));
+    CHECK_EQ(toTicks(parseDecimal("3e2"), 10), Time(3000));
+    CHECK_EQ(toTicks(parseDecimal("1e-30"), 1), Time(0));
+    CHECK_EQ(toTicks(parseDecimal("0e30"), 1), Time(0));
+    CHECK_EQ(toTicks(parseDecimal("9.2e18"), 1), Time(9'200'000'000'000'000'000));
+    CHECK_THROWS(toTicks(parseDecimal("9.3e18"), 1));
+    CHECK_THROWS(toTicks(parseDecimal("1e18"), 100));
+    CHECK_THROWS(toTicks(parseDecimal("1e30"), 1));
+}
+
+static void timeBases() {
+    auto path = writeInput("rt_sched_test_base.in",
+                           "# comment\n"
+                           "P 0 0.25 2 2   # trailing comment\n"
+                           "P 1.5 4\n"
+                           "A 0.75 0.5\n"
+                           "D 1 4 4\n");
+    TimeBase base;
+    base.autoDetect = true;
+    auto [tasks, aperiodic, server] = parseInputFile(path, base);
+    CHECK_EQ(base.ticksPerUnit, Time(4));
+    CHECK_EQ(tasks.size(), std::size_t(2));
+    CHECK_EQ(tasks[0].execTime, Time(1));
+    CHECK_EQ(tasks[0].period, Time(8));
+    CHECK_EQ(tasks[1].execTime, Time(6));
+    CHECK_EQ(tasks[1].deadline, Time(16));
+    CHECK_EQ(aperiodic[0].releaseTime, Time(3));
+    CHECK_EQ(aperiodic[0].execTime, Time(2));
+    CHECK(server.has_value() && server->Q == 4 && server->T == 16);
+
+    // explicit base: rounded, not detected
+    base = TimeBase{10, false};
+    std::tie(tasks, aperiodic, server) = parseInputFile(path, base);
+    CHECK_EQ(base.ticksPerUnit, Time(10));
+    CHECK_EQ(tasks[0].execTime, Time(3));   // 2.5 ticks, rounded up
+
+    // integers only: auto picks 1; 0.5 and 0.1 need 10, not 2
+    path = writeInput("rt_sched_test_int.in", "P 0 1 4 4\nP 2 5\n");
+    base = TimeBase{1, true};
+    parseInputFile(path, base);
+    CHECK_EQ(base.ticksPerUnit, Time(1));
+    path = writeInput("rt_sched_test_tenths.in", "P 0 0.5 4 4\nP 0.1 5\n");
+    base = TimeBase{1, true};
+    parseInputFile(path, base);
+    CHECK_EQ(base.ticksPerUnit, Time(10));
+
+    // values rounding to 0 ticks are rejected with their line
+    path = writeInput("rt_sched_test_zero.in", "P 0.4 4\n");
+    base = TimeBase{};
+    try {
+        parseInputFile(path, base);
+        CHECK(false);
+    } catch (const std::exception& e) {
+        CHECK(std::string(e.what()).find("line 1") != std::string::npos);
+    }
+    base = TimeBase{0, false};
+    CHECK_THROWS(parseInputFile(path, base));
+    path = writeInput("rt_sched_test_bad.in", "P 1 4\nX 1 2\n");
+    base = TimeBase{};
+    CHECK_THROWS(parseInputFile(path, base));
+
+    // aperiodic jobs and the server are validated like P lines
+    for (const char* line : {"A 2 -2", "A 2 0", "A -1 2", "A 1 0.4",
+                             "D 0 4 4", "D 1 0 4", "D 1 4 0", "D 0.4 0.4 0.4"}) {
+        path = writeInput("rt_sched_test_bad.in", std::string("P 1 4\n") + line + "\n");
+        base = TimeBase{};
+        CHECK_THROWS(parseInputFile(path, base));
+    }
+}
+
+int main() {
+    decimals();
+    ticks();
+    timeBases();
+    return checkResult();
+}
@@ -0,0 +1,80 @@
+// ThreadPool: nested submits, wait() and exception propagation
+
+#include "check.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+// Tasks that submit children from inside a worker: wait() may only return
+// once every parent and child has finished
+static void nestedSubmit() {
+    for (int round = 0; round < 50; ++round) {
+        ThreadPool pool(4);
+        std::atomic<int> parents{0}, children{0};
+        const int kParents = 16, kChildren = 8;
+        for (int p = 0; p < kParents; ++p) {
+            pool.submit([&] {
+                for (int c = 0; c < kChildren; ++c) {
+                    pool.submit([&] { children.fetch_add(1); });
+                }
+                // give idle workers time to steal and finish the children
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                parents.fetch_add(1);
+            });
+        }
+        pool.wait();
+        CHECK_EQ(parents.load(), kParents);
+        CHECK_EQ(children.load(), kParents * kChildren);
+    }
+}
+
+// One parent, so pending_ only stays above zero through its own count:
+// a child finished before being counted would let wait() return early
+static void nestedSingleParent() {
+    for (int round = 0; round < 20000; ++round) {
+        ThreadPool pool(4);
+        std::atomic<bool> parentDone{false};
+        pool.submit([&] {
+            for (int c = 0; c < 50; ++c) pool.submit([] {});
+            for (volatile int spin = 0; spin < 2000; ++spin) {}
+            parentDone.store(true);
+        });
+        pool.wait();
+        CHECK(parentDone.load());
+    }
+}
+
+static void waitIsReusable() {
+    ThreadPool pool(3);
+    std::atomic<int> n{0};
+    for (int batch = 0; batch < 3; ++batch) {
+        for (int i = 0; i < 100; ++i) pool.submit([&] { n.fetch_add(1); });
+        pool.wait();
+        CHECK_EQ(n.load(), (batch + 1) * 100);
+    }
+}
+
+static void rethrowsFirstError() {
+    ThreadPool pool(2);
+    std::atomic<int> n{0};
+    for (int i = 0; i < 10; ++i) {
+        pool.submit([&, i] {
+            n.fetch_add(1);
+            if (i == 3) throw std::runtime_error("task failed");
+        });
+    }
+    CHECK_THROWS(pool.wait());
+    CHECK_EQ(n.load(), 10);
+    pool.wait();   // the error is reported once
+}
+
+int main() {
+    nestedSubmit();
+    nestedSingleParent();
+    waitIsReusable();
+    rethrowsFirstError();
+    return checkResult();
+}
@@ -0,0 +1,137 @@
+// Binary trace: write, map back, rebuild the timeline
+
+#include "check.hpp"
+#include "factory.hpp"
+#include "fixtures.hpp"
+#include "trace.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <vector>
+
+static std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+using Run = std::tuple<Time, Time, std::string>;   // start, length, label
+
+static std::vector<Run> runsOf(const Timeline& tl) {
+    std::vector<Run> out;
+    tl.forEachRun([&](const TimelineSegment& s) {
+        out.emplace_back(s.start, s.length, tl.labelName(s.label));
+    });
+    return out;
+}
+
+// Records come back field for field, labels and simTime from the tail
+static void recordsRoundTrip() {
+    std::string path = tempPath("rt_sched_test_records.trace");
+    {
+        TraceWriter w(path, 2);   // tiny block: several flushes
+        w.write(TraceEvent::Release, 0, 0, 0, 3);
+        w.write(TraceEvent::Run, 0, 0, 0, 1, 2);
+        w.write(TraceEvent::AperiodicRelease, 4, 1, 0, 5);
+        w.write(TraceEvent::Run, 2, 0, 7'000'000'000LL, 0, 1);
+        w.write(TraceEvent::Budget, 9, 2, 0, 4);
+        CHECK_EQ(w.recordCount(), std::uint64_t(5));
+        w.close({"T1", "A1", "S"}, 10);
+    }
+    TraceReader r(path);
+    CHECK_EQ(r.size(), std::size_t(5));
+    CHECK_EQ(r.simTime(), Time(10));
+    CHECK(r.labels() == std::vector<std::string>({"T1", "A1", "S"}));
+    CHECK_EQ(static_cast<int>(r[2].type), static_cast<int>(TraceEvent::AperiodicRelease));
+    CHECK_EQ(r[2].time, Time(4));
+    CHECK_EQ(r[2].label, 1);
+    CHECK_EQ(r[2].remaining, Time(5));
+    CHECK_EQ(r[3].job, std::int64_t(7'000'000'000LL));
+    CHECK_EQ(r[3].length, Time(1));
+    CHECK_EQ(r[4].remaining, Time(4));
+    std::filesystem::remove(path);
+}
+
+// A traced run rebuilds to the scheduler's own timeline
+static void timelineRoundTrip() {
+    auto set = makeTestSet(4, 0.7, 3);
+
+    std::string path = tempPath("rt_sched_test_run.trace");
+    for (const char* alg : {"EDF", "LLF", "BACKGROUND", "SPORADIC"}) {
+        auto s = buildScheduler(alg, set.tasks, set.aperiodic, set.serverCfg, 500,
+                                ServerRuleConfig{});
+        std::size_t records = 0;
+        {
+            TraceWriter w(path);
+            s->setTrace(&w);
+            s->run();
+            records = w.recordCount();
+            w.close(s->timeline().labels(), s->simTime());
+        }
+        TraceReader r(path);
+        CHECK_EQ(r.size(), records);
+        CHECK_EQ(r.simTime(), s->simTime());
+        CHECK(runsOf(r.timeline()) == runsOf(s->timeline()));
+
+        std::size_t completes = 0, misses = 0;
+        for (const auto &rec : r) {
+            if (rec.type == static_cast<std::uint8_t>(TraceEvent::Complete)) ++completes;
+            if (rec.type == static_cast<std::uint8_t>(TraceEvent::Miss)) ++misses;
+        }
+        CHECK_EQ(completes, s->finished().size());
+        CHECK_EQ(misses, s->missed().size());
+    }
+    std::filesystem::remove(path);
+}
+
+static void rejectsBadFiles() {
+    std::string path = tempPath("rt_sched_test_bad.trace");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a trace";
+    }
+    CHECK_THROWS(TraceReader(path));
+
+    // valid header, label table cut off
+    {
+        TraceWriter w(path);
+        w.write(TraceEvent::Run, 0, 0, 0, 0, 1);
+        w.close({"a fairly long label"}, 1);
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+    CHECK_THROWS(TraceReader(path));
+
+    // record count whose byte size wraps around to match labelsOffset
+    {
+        TraceHeader h{};
+        std::memcpy(h.magic, kTraceMagic, sizeof(kTraceMagic));
+        h.version = kTraceVersion;
+        h.recordSize = sizeof(TraceRecord);
+        h.recordCount = (std::numeric_limits<std::uint64_t>::max() - 15) / 40 + 1;
+        h.labelsOffset = sizeof(TraceHeader) + 24;     // recordCount * 40 mod 2^64
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out << std::string(24 + sizeof(std::uint32_t), '\0');   // empty label table
+    }
+    CHECK_THROWS(TraceReader(path));
+
+    // header cut short
+    {
+        TraceWriter w(path);
+        w.close({}, 1);
+    }
+    std::filesystem::resize_file(path, sizeof(TraceHeader) - 1);
+    CHECK_THROWS(TraceReader(path));
+
+    CHECK_THROWS(TraceReader(tempPath("rt_sched_test_missing.trace")));
+    std::filesystem::remove(path);
+}
+
+int main() {
+    recordsRoundTrip();
+    timelineRoundTrip();
+    rejectsBadFiles();
+    return checkResult();
+}